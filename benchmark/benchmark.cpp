@@ -0,0 +1,510 @@
+//
+//  benchmark.cpp
+//  benchmark
+//
+//  Times the stages of an optSchedule solve on synthetic bridges, without SenStore or the
+//  Data files, and writes one CSV row per stage and case. At the default horizon of 100
+//  years the original schedule DPs of tests/BaselineKernels.cpp are timed as well, so that
+//  the rows of findOpt*Schedule can be compared with them; a case whose schedules differ
+//  from theirs is reported, and the benchmark then exits with 1.
+//
+//  Usage: benchmark [-o results.csv] [-t seconds] [-s seed]
+//
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <cstdlib>
+#include <cstring>
+#include <math.h>
+#include <IceUtil/IceUtil.h>
+#include "Input.h"
+#include "EnvImpact.h"
+#include "FindOptSchedule.h"
+#include "DecaySampling.h"
+#include "BaselineKernels.h"
+
+using namespace std;
+
+/*
+ * Struct: BenchCase
+ * -------------------------------------------------------
+ * One point of the sweep, and the synthetic inputs generated for it. The repairs of every
+ * part are compiled once, for the stages after envInfoCompiler to use.
+ */
+struct BenchCase {
+	string component;
+	int catalogue;
+	int horizon;
+
+	BridgeInfo bridge;
+	ComponentRatingMat ratings;
+	int limit;
+	int ratingsDecay[10][10];
+	RepairInfoMat repairUserIn;
+	RepairBasicInfoMat basicInfo;
+	EnvCoefMat envCoef;
+	RepairCatalog catalog;
+	CostMap costs;
+	ImproveMat impMat;
+	YearFactors factors;
+	vector<string> parts;
+	vector<RepairEnvMat> repairs;
+};
+
+/*
+ * Struct: Measurement
+ * -------------------------------------------------------
+ * Time of one call of a stage, in microseconds, over the blocks of calls that were timed.
+ */
+struct Measurement {
+	long calls;
+	double mean;
+	double minimum;
+	double maximum;
+};
+
+/*
+ * Function: uniformBetween
+ * -------------------------------------------------------
+ * A number in lo .. hi, each as likely.
+ */
+static int uniformBetween(SampleStream &random, int lo, int hi)
+{
+	return lo + random.uniform(hi - lo + 1);
+}
+
+/*
+ * Function: syntheticRatings
+ * -------------------------------------------------------
+ * Assessments every two or three years of a component decaying along a quadratic from 9,
+ * rounded to whole ratings, drawn until ratingDecay accepts the history.
+ */
+static ComponentRatingMat syntheticRatings(SampleStream &random, int limit, int ratingsDecay[][10])
+{
+	while (true) {
+		ComponentRatingMat ratings;
+		float a = -0.002f*uniformBetween(random, 2, 10);
+		float b = -0.01f*uniformBetween(random, 1, 10);
+		int year = 1970 + uniformBetween(random, 0, 20);
+		for (int k = 0; k < 12; k++) {
+			float t = (float)(k == 0 ? 0 : year - ratings.years[0]);
+			int rating = (int)floor(9 + b*t + a*t*t + 0.5f) + uniformBetween(random, -1, 1)*(random.uniform(4) == 0);
+			ratings.years.push_back(year);
+			ratings.ratings.push_back(max(0, min(9, rating)));
+			year += uniformBetween(random, 2, 3);
+		}
+		try {
+			ratingDecay(ratingsDecay, ratings, limit);
+			return ratings;
+		} catch (const BlackBoxError &) {
+		}
+	}
+}
+
+/*
+ * Function: makeCase
+ * -------------------------------------------------------
+ * A bridge of the component type with "catalogue" repairs, each known for every part with a
+ * random band, improvement and coefficients, and offered by the user at a random cost.
+ * The repairIDs are 1 .. catalogue, so a catalogue holds at most the 51 repairs of SenStore.
+ */
+static BenchCase makeCase(SampleStream &random, const string &component, int catalogue, int horizon)
+{
+	BenchCase bench;
+	bench.component = component;
+	bench.catalogue = catalogue;
+	bench.horizon = horizon;
+	if (component == "Span") {
+		bench.parts.push_back("Deck");
+		bench.parts.push_back("Barrier");
+		bench.parts.push_back("Joint");
+		bench.parts.push_back("Other");
+	} else {
+		bench.parts.push_back(component);
+	}
+
+	UserInput userIn;
+	userIn.bridgeID = 1;
+	userIn.bridgeAADT = (float)uniformBetween(random, 5000, 50000);
+	userIn.bridgeAADTT = userIn.bridgeAADT*0.1f;
+	userIn.trafficGrowthRate = 0.02f;
+	userIn.discountRate = 0.04f;
+	userIn.componentID = 1;
+	userIn.ratingLowerLimit = 4;
+	userIn.startRating = 8;
+	userIn.startYear = 2012;
+	userIn.optObject = 11;
+	userIn.horizon = horizon;
+	userIn.ratingLevels = 0;
+	ServerInput serverIn;
+	serverIn.bridgeWidth = (float)uniformBetween(random, 8, 30);
+	serverIn.bridgeLength = (float)uniformBetween(random, 20, 400);
+	serverIn.componentType = component == "Span" ? StructureComponentTypeSpan : StructureComponentTypeDeck;
+	bench.bridge = bridgeInfoCompiler(userIn, serverIn);
+	bench.limit = userIn.ratingLowerLimit;
+	bench.ratings = syntheticRatings(random, bench.limit, bench.ratingsDecay);
+
+	for (int repairID = 1; repairID <= catalogue; repairID++) {
+		for (int p = 0; p < bench.parts.size(); p++) {
+			RepairBasicInfo basic;
+			basic.repairID = repairID;
+			basic.component = bench.parts[p];
+			basic.LB = uniformBetween(random, bench.limit, 7);
+			basic.UB = min(basic.LB + uniformBetween(random, 0, 3), 8);
+			basic.improvement = random.uniform(8) == 0 ? 7 : uniformBetween(random, 1, 3);
+			bench.basicInfo.push_back(basic);
+		}
+		EnvCoef coef;
+		coef.repairID = repairID;
+		coef.repairMean = 0.01f*uniformBetween(random, 1, 1000);
+		coef.trafficMean = 0.0001f*uniformBetween(random, 1, 1000);
+		bench.envCoef.push_back(coef);
+
+		RepairInfo repair;
+		repair.repairID = repairID;
+		repair.duration = uniformBetween(random, 1, 60);
+		repair.cost = uniformBetween(random, 1000, 500000);
+		repair.avail = true;
+		bench.repairUserIn.push_back(repair);
+	}
+	bench.catalog = repairCatalogCompiler(bench.basicInfo, bench.envCoef);
+	bench.costs = readRepairCost(bench.repairUserIn);
+	bench.factors = yearFactorsCompiler(bench.bridge, bench.bridge.nYears);
+
+	const int conditions[3] = { 4, 5, 6 };
+	const float coefficients[3] = { 0.15f, 0.1f, 0.05f };
+	for (int c = 0; c < 3; c++) {
+		ImpCoef imp;
+		imp.condition = conditions[c];
+		imp.coef = coefficients[c];
+		bench.impMat.push_back(imp);
+	}
+
+	for (int p = 0; p < bench.parts.size(); p++)
+		bench.repairs.push_back(envInfoCompiler(bench.repairUserIn, bench.parts[p], bench.basicInfo, bench.envCoef, bench.catalog));
+	return bench;
+}
+
+/*
+ * Class: Stage
+ * -------------------------------------------------------
+ * One stage of the pipeline; run() makes one call of it on the inputs of a case.
+ */
+class Stage {
+public:
+	Stage(const BenchCase &bench) : _bench(bench) {}
+	virtual ~Stage() {}
+	virtual const char *name() const = 0;
+	virtual void run() = 0;
+
+protected:
+	const BenchCase &_bench;
+};
+
+class RatingDecayStage : public Stage {
+public:
+	RatingDecayStage(const BenchCase &bench) : Stage(bench) {}
+	const char *name() const { return "ratingDecay"; }
+	void run() {
+		int ratingsDecay[10][10];
+		ratingDecay(ratingsDecay, _bench.ratings, _bench.limit);
+	}
+};
+
+class EnvInfoStage : public Stage {
+public:
+	EnvInfoStage(const BenchCase &bench) : Stage(bench) {}
+	const char *name() const { return "envInfoCompiler"; }
+	void run() {
+		for (int p = 0; p < _bench.parts.size(); p++)
+			envInfoCompiler(_bench.repairUserIn, _bench.parts[p], _bench.basicInfo, _bench.envCoef, _bench.catalog);
+	}
+};
+
+class EnvScheduleStage : public Stage {
+public:
+	EnvScheduleStage(const BenchCase &bench) : Stage(bench) {}
+	const char *name() const { return "findOptEnvSchedule"; }
+	void run() {
+		for (int p = 0; p < _bench.parts.size(); p++) {
+			RepairSchedule schedule;
+			findOptEnvSchedule(_bench.bridge, const_cast<int (*)[10]>(_bench.ratingsDecay), _bench.repairs[p], _bench.impMat, _bench.factors, _bench.limit, schedule, "");
+		}
+	}
+};
+
+class CostScheduleStage : public Stage {
+public:
+	CostScheduleStage(const BenchCase &bench) : Stage(bench) {}
+	const char *name() const { return "findOptCostSchedule"; }
+	void run() {
+		for (int p = 0; p < _bench.parts.size(); p++) {
+			RepairSchedule schedule;
+			findOptCostSchedule(_bench.bridge, const_cast<int (*)[10]>(_bench.ratingsDecay), _bench.repairs[p], _bench.costs, _bench.impMat, _bench.factors, _bench.limit, schedule, "");
+		}
+	}
+};
+
+class YearFactorsStage : public Stage {
+public:
+	YearFactorsStage(const BenchCase &bench) : Stage(bench) {}
+	const char *name() const { return "yearFactorsCompiler"; }
+	void run() {
+		yearFactorsCompiler(_bench.bridge, _bench.bridge.nYears);
+	}
+};
+
+class CostTableStage : public Stage {
+public:
+	CostTableStage(const BenchCase &bench) : Stage(bench) {}
+	const char *name() const { return "costTableCompiler"; }
+	void run() {
+		for (int p = 0; p < _bench.parts.size(); p++)
+			costTableCompiler(_bench.bridge, _bench.repairs[p], _bench.costs, _bench.impMat, _bench.factors, _bench.limit);
+	}
+};
+
+/*
+ * One sample of optScheduleUncertainty: a decay curve drawn around the fit and the cost DP of
+ * every part on the tables built beforehand. A rejected curve is not solved, as in the solve.
+ */
+class UncertaintySampleStage : public Stage {
+public:
+	UncertaintySampleStage(const BenchCase &bench) : Stage(bench), _sampler(bench.ratings), _random(1, 0) {
+		for (int p = 0; p < bench.parts.size(); p++)
+			_tables.push_back(costTableCompiler(bench.bridge, bench.repairs[p], bench.costs, bench.impMat, bench.factors, bench.limit));
+	}
+	const char *name() const { return "uncertaintySample"; }
+	void run() {
+		int ratingsDecay[10][10];
+		if (!_sampler.sample(_random, _bench.limit, ratingsDecay))
+			return;
+		for (int p = 0; p < _tables.size(); p++) {
+			RepairSchedule schedule;
+			findOptCostSchedule(_bench.bridge, ratingsDecay, _tables[p], _bench.limit, schedule, "");
+		}
+	}
+
+private:
+	DecaySampler _sampler;
+	SampleStream _random;
+	vector<RepairCostTable> _tables;
+};
+
+/*
+ * The original DPs, which evaluate pow() and scan the repairs for every transition.
+ */
+class BaselineEnvStage : public Stage {
+public:
+	BaselineEnvStage(const BenchCase &bench) : Stage(bench) {}
+	const char *name() const { return "baselineEnvSchedule"; }
+	void run() {
+		for (int p = 0; p < _bench.parts.size(); p++) {
+			RepairSchedule schedule;
+			baselineEnvSchedule(_bench.bridge, const_cast<int (*)[10]>(_bench.ratingsDecay), _bench.repairs[p], _bench.impMat, _bench.limit, schedule);
+		}
+	}
+};
+
+class BaselineCostStage : public Stage {
+public:
+	BaselineCostStage(const BenchCase &bench) : Stage(bench) {}
+	const char *name() const { return "baselineCostSchedule"; }
+	void run() {
+		for (int p = 0; p < _bench.parts.size(); p++) {
+			RepairSchedule schedule;
+			baselineCostSchedule(_bench.bridge, const_cast<int (*)[10]>(_bench.ratingsDecay), _bench.repairs[p], _bench.costs, _bench.impMat, _bench.limit, schedule);
+		}
+	}
+};
+
+/*
+ * Function: fitsBaseline
+ * -------------------------------------------------------
+ * Whether the original DPs can solve the case: they are fixed to 101 years and 9 ratings.
+ */
+static bool fitsBaseline(const BenchCase &bench)
+{
+	if (bench.bridge.nYears != 101 || bench.bridge.nRatings != 9)
+		return false;
+	for (int i = 9; i >= bench.limit; i--) {
+		for (int j = i; j >= bench.limit; j--) {
+			if (bench.ratingsDecay[i][j] < 0 || bench.ratingsDecay[i][j] > 100)
+				return false;
+		}
+	}
+	return true;
+}
+
+/*
+ * Function: sameAsBaseline
+ * -------------------------------------------------------
+ * Whether findOptEnvSchedule and findOptCostSchedule give every part of the case the minimum
+ * and the repairs of the original DPs, so that the times compared are those of one answer.
+ */
+static bool sameAsBaseline(const BenchCase &bench)
+{
+	int (*ratingsDecay)[10] = const_cast<int (*)[10]>(bench.ratingsDecay);
+	for (int p = 0; p < bench.parts.size(); p++) {
+		for (int cost = 0; cost < 2; cost++) {
+			RepairSchedule schedule, expected;
+			float minimum, expectedMinimum;
+			if (cost) {
+				minimum = findOptCostSchedule(bench.bridge, ratingsDecay, bench.repairs[p], bench.costs, bench.impMat, bench.factors, bench.limit, schedule, "");
+				expectedMinimum = baselineCostSchedule(bench.bridge, ratingsDecay, bench.repairs[p], bench.costs, bench.impMat, bench.limit, expected);
+			} else {
+				minimum = findOptEnvSchedule(bench.bridge, ratingsDecay, bench.repairs[p], bench.impMat, bench.factors, bench.limit, schedule, "");
+				expectedMinimum = baselineEnvSchedule(bench.bridge, ratingsDecay, bench.repairs[p], bench.impMat, bench.limit, expected);
+			}
+			// an unsolvable part has a NaN minimum in both
+			bool bothUnsolved = minimum != minimum && expectedMinimum != expectedMinimum;
+			if (minimum != expectedMinimum && !bothUnsolved)
+				return false;
+			// without a schedule within the limit the original backtracked from no final condition
+			if (minimum == numeric_limits<float>::infinity())
+				continue;
+			if (schedule.size() != expected.size())
+				return false;
+			for (int r = 0; r < schedule.size(); r++) {
+				if (schedule[r].repairID != expected[r].repairID || schedule[r].repairYear != expected[r].repairYear)
+					return false;
+			}
+		}
+	}
+	return true;
+}
+
+/*
+ * The schedules merged are the cost optima of the four parts, solved once beforehand.
+ */
+class MergeStage : public Stage {
+public:
+	MergeStage(const BenchCase &bench) : Stage(bench), _schedules(4) {
+		for (int p = 0; p < bench.parts.size() && p < 4; p++)
+			findOptCostSchedule(bench.bridge, const_cast<int (*)[10]>(bench.ratingsDecay), bench.repairs[p], bench.costs, bench.impMat, bench.factors, bench.limit, _schedules[p], "");
+	}
+	const char *name() const { return "mergeFourSched"; }
+	void run() {
+		mergeFourSched(_schedules[0], _schedules[1], _schedules[2], _schedules[3]);
+	}
+
+private:
+	vector<RepairSchedule> _schedules;
+};
+
+/*
+ * Function: measure
+ * -------------------------------------------------------
+ * Calls are timed in blocks, doubled until a block takes a millisecond so that the clock's
+ * resolution does not matter, and blocks are timed until "seconds" have passed.
+ */
+static Measurement measure(Stage &stage, double seconds)
+{
+	const IceUtil::Time minBlock = IceUtil::Time::milliSeconds(1);
+	long block = 1;
+	while (true) {
+		IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+		for (long c = 0; c < block; c++)
+			stage.run();
+		if (IceUtil::Time::now(IceUtil::Time::Monotonic) - start >= minBlock)
+			break;
+		block *= 2;
+	}
+
+	Measurement result;
+	result.calls = 0;
+	result.minimum = result.maximum = 0;
+	double total = 0;
+	IceUtil::Time end = IceUtil::Time::now(IceUtil::Time::Monotonic) + IceUtil::Time::milliSeconds((long)(seconds*1000));
+	do {
+		IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+		for (long c = 0; c < block; c++)
+			stage.run();
+		double perCall = (double)(IceUtil::Time::now(IceUtil::Time::Monotonic) - start).toMicroSeconds()/block;
+		if (result.calls == 0 || perCall < result.minimum)
+			result.minimum = perCall;
+		if (result.calls == 0 || perCall > result.maximum)
+			result.maximum = perCall;
+		total += perCall*block;
+		result.calls += block;
+	} while (IceUtil::Time::now(IceUtil::Time::Monotonic) < end);
+	result.mean = total/result.calls;
+	return result;
+}
+
+int main(int argc, char *argv[])
+{
+	string outFile;
+	double seconds = 0.2;
+	unsigned int seed = 1;
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "-o") == 0 && i+1 < argc)
+			outFile = argv[++i];
+		else if (strcmp(argv[i], "-t") == 0 && i+1 < argc)
+			seconds = atof(argv[++i]);
+		else if (strcmp(argv[i], "-s") == 0 && i+1 < argc)
+			seed = (unsigned int)atoi(argv[++i]);
+		else {
+			cerr << "Usage: " << argv[0] << " [-o results.csv] [-t seconds per stage] [-s seed]" << endl;
+			return 1;
+		}
+	}
+
+	ofstream file;
+	if (!outFile.empty()) {
+		file.open(outFile.c_str());
+		if (!file) {
+			cerr << "Unable to open " << outFile << endl;
+			return 1;
+		}
+	}
+	ostream &out = outFile.empty() ? cout : file;
+
+	// the sweep: component types, repair catalogue sizes and planning horizons
+	const char *components[] = { "Deck", "Span" };
+	const int catalogues[] = { 10, 25, 51 };
+	const int horizons[] = { 25, 50, 100 };
+
+	int status = 0;
+	out << "stage,component,parts,catalogue,horizon,calls,mean_us,min_us,max_us" << endl;
+	SampleStream random(seed, 0);
+	for (int c = 0; c < sizeof(components)/sizeof(components[0]); c++) {
+		for (int r = 0; r < sizeof(catalogues)/sizeof(catalogues[0]); r++) {
+			for (int h = 0; h < sizeof(horizons)/sizeof(horizons[0]); h++) {
+				BenchCase bench = makeCase(random, components[c], catalogues[r], horizons[h]);
+
+				vector<Stage*> stages;
+				stages.push_back(new RatingDecayStage(bench));
+				stages.push_back(new EnvInfoStage(bench));
+				stages.push_back(new YearFactorsStage(bench));
+				stages.push_back(new CostTableStage(bench));
+				stages.push_back(new EnvScheduleStage(bench));
+				stages.push_back(new CostScheduleStage(bench));
+				stages.push_back(new UncertaintySampleStage(bench));
+				if (fitsBaseline(bench)) {
+					if (!sameAsBaseline(bench)) {
+						cerr << "The schedules of the " << bench.component << " case with " << bench.catalogue
+							<< " repairs differ from those of the original DPs" << endl;
+						status = 1;
+					}
+					stages.push_back(new BaselineEnvStage(bench));
+					stages.push_back(new BaselineCostStage(bench));
+				}
+				if (bench.parts.size() == 4)
+					stages.push_back(new MergeStage(bench));
+
+				for (int s = 0; s < stages.size(); s++) {
+					Measurement m = measure(*stages[s], seconds);
+					out << stages[s]->name() << "," << bench.component << "," << bench.parts.size() << "," << bench.catalogue << ","
+						<< bench.horizon << "," << m.calls << "," << m.mean << "," << m.minimum << "," << m.maximum << endl;
+					delete stages[s];
+				}
+			}
+		}
+	}
+	return status;
+}
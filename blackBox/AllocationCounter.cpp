@@ -0,0 +1,43 @@
+#include "AllocationCounter.h"
+
+#ifdef COUNT_ALLOCATIONS
+#include <cstdlib>
+#include <new>
+
+// one counter per thread, so that counting takes no lock
+#ifdef _MSC_VER
+static __declspec(thread) long allocations = 0;
+#else
+static __thread long allocations = 0;
+#endif
+
+/*
+ * Implementation: operator new
+ * ------------------------------
+ * The replacement of the global operator new: counts, then allocates with malloc. operator new[]
+ * and the nothrow forms call this one, and operator delete frees what it returns.
+ */
+void *operator new(size_t size) throw(std::bad_alloc) {
+	allocations++;
+	if (size == 0)
+		size = 1;
+	while (true) {
+		void *p = malloc(size);
+		if (p)
+			return p;
+		std::new_handler handler = std::set_new_handler(0);
+		std::set_new_handler(handler);
+		if (!handler)
+			throw std::bad_alloc();
+		handler();
+	}
+}
+
+void operator delete(void *p) throw() {
+	free(p);
+}
+
+long threadAllocations() {
+	return allocations;
+}
+#endif
@@ -0,0 +1,28 @@
+//
+//  AllocationCounter.h
+//  blackBox
+//
+//  Count of the heap allocations made by a thread, to check that the loops of the DP do not
+//  allocate. Counting replaces the global operator new, so it is only built with
+//  COUNT_ALLOCATIONS defined, as in the Debug configuration.
+//
+
+#ifndef blackBox_AllocationCounter_h
+#define blackBox_AllocationCounter_h
+
+/*
+ * Function: threadAllocations
+ * Usage: long before = threadAllocations();
+ * -----------------------------------------------------------------------------
+ * The number of calls of operator new made so far by the calling thread; the difference of
+ * two calls is what was allocated between them. Always 0 without COUNT_ALLOCATIONS.
+ */
+#ifdef COUNT_ALLOCATIONS
+long threadAllocations();
+#else
+inline long threadAllocations() {
+	return 0;
+}
+#endif
+
+#endif
@@ -0,0 +1,99 @@
+//
+//  Atomic.h
+//  blackBox
+//
+//  Atomic operations on values shared by threads without a lock: the Interlocked functions
+//  with Visual C++, the __sync builtins with gcc.
+//
+
+#ifndef blackBox_Atomic_h
+#define blackBox_Atomic_h
+
+#ifdef _MSC_VER
+#include <windows.h>
+#endif
+
+/*
+ * Function: atomicIncrement
+ * Usage: atomicIncrement(&counter);
+ * -----------------------------------------------------------------------------
+ * Add 1 to the counter.
+ */
+inline void atomicIncrement(volatile long *counter) {
+#ifdef _MSC_VER
+	InterlockedIncrement(counter);
+#else
+	__sync_add_and_fetch(counter, 1);
+#endif
+}
+
+/*
+ * Function: atomicExchange
+ * Usage: old = atomicExchange(&counter, 0);
+ * -----------------------------------------------------------------------------
+ * Store the value and return the one it replaced.
+ */
+inline long atomicExchange(volatile long *target, long value) {
+#ifdef _MSC_VER
+	return InterlockedExchange(target, value);
+#else
+	return __sync_lock_test_and_set(target, value);
+#endif
+}
+
+/*
+ * Function: atomicCompareAndSwap
+ * Usage: if (atomicCompareAndSwap(&position, seen, next) == seen) ...
+ * -----------------------------------------------------------------------------
+ * Store "value" if the target holds "expected"; returns what the target held, so the store
+ * was made if that is "expected".
+ */
+inline long atomicCompareAndSwap(volatile long *target, long expected, long value) {
+#ifdef _MSC_VER
+	return InterlockedCompareExchange(target, value, expected);
+#else
+	return __sync_val_compare_and_swap(target, expected, value);
+#endif
+}
+
+/*
+ * Function: atomicLoad, atomicStore
+ * Usage: if (atomicLoad(&slot.sequence) == position) ...
+ *        atomicStore(&slot.sequence, position + 1);
+ * -----------------------------------------------------------------------------
+ * A read that later reads are not moved before, and a write that earlier writes are not
+ * moved after, so that a value published with atomicStore is seen whole after atomicLoad.
+ * Volatile accesses have these semantics with Visual C++ 2005 and later.
+ */
+inline long atomicLoad(const volatile long *value) {
+	long read = *value;
+#ifndef _MSC_VER
+	__sync_synchronize();
+#endif
+	return read;
+}
+
+inline void atomicStore(volatile long *target, long value) {
+#ifndef _MSC_VER
+	__sync_synchronize();
+#endif
+	*target = value;
+}
+
+/*
+ * Function: atomicMaximum
+ * Usage: atomicMaximum(&longest, elapsed);
+ * -----------------------------------------------------------------------------
+ * Raise the target to the value if it is lower.
+ */
+inline void atomicMaximum(volatile long *maximum, long value) {
+	long current = *maximum;
+	while (value > current) {
+		long seen = atomicCompareAndSwap(maximum, current, value);
+		if (seen == current)
+			return;
+		current = seen;
+	}
+}
+
+#endif
@@ -0,0 +1,49 @@
+#include <iostream>
+#include "BlackBoxAdminI.h"
+#include "Logger.h"
+
+using namespace std;
+
+BlackBoxAdminI::BlackBoxAdminI(const ReferenceDataStorePtr& referenceData, const ResultCachePtr& resultCache, const DecayCachePtr& decayCache,
+	const ThreadPoolPtr& requestPool, const LatencyStatsPtr& latency) :
+	_referenceData(referenceData), _resultCache(resultCache), _decayCache(decayCache), _requestPool(requestPool), _latency(latency)
+{
+}
+
+/*
+ * Implementation: reloadReferenceData
+ * ------------------------------------
+ *
+ */
+void 
+BlackBoxAdminI::
+reloadReferenceData(const ::Ice::Current&)
+{
+	_referenceData->reload();
+	LOG_INFO("Reference data reloaded, version " << _referenceData->current()->version());
+}
+
+CacheStats 
+BlackBoxAdminI::
+getResultCacheStats(const ::Ice::Current&)
+{
+	return _resultCache->stats();
+}
+
+/*
+ * Implementation: getStats
+ * ------------------------------------
+ * Each part is read on its own, so they may be a few requests apart.
+ */
+ServerStats 
+BlackBoxAdminI::
+getStats(const ::Ice::Current&)
+{
+	ServerStats stats;
+	stats.stages = _latency->stats();
+	stats.resultCache = _resultCache->stats();
+	stats.decayCache = _decayCache->stats();
+	stats.queued = _requestPool->queued();
+	stats.workers = _requestPool->size();
+	return stats;
+}
@@ -0,0 +1,43 @@
+//
+//  BlackBoxAdminI.h
+//  blackBox
+//
+//  Servant of the Ice interface LCO::BlackBoxAdmin.
+//
+
+#ifndef blackBox_BlackBoxAdminI_h
+#define blackBox_BlackBoxAdminI_h
+
+#include "LCO.h"
+#include "ReferenceData.h"
+#include "ResultCache.h"
+#include "DecayCache.h"
+#include "LatencyStats.h"
+#include "ThreadPool.h"
+#include <Ice/Ice.h>
+
+using namespace LCO;
+
+/*
+ * Class: BlackBoxAdminI
+ * -----------------------------------------------------------------------------
+ * BlackBoxAdminI is the incarnation of the interface BlackBoxAdmin.
+ * It is registered as "BlackBoxAdmin" on the adapter of the BlackBox.
+ */
+class BlackBoxAdminI : public BlackBoxAdmin {
+public:
+	BlackBoxAdminI(const ReferenceDataStorePtr& referenceData, const ResultCachePtr& resultCache, const DecayCachePtr& decayCache,
+		const ThreadPoolPtr& requestPool, const LatencyStatsPtr& latency);
+	virtual void reloadReferenceData(const ::Ice::Current&);
+	virtual CacheStats getResultCacheStats(const ::Ice::Current&);
+	virtual ServerStats getStats(const ::Ice::Current&);
+
+private:
+	ReferenceDataStorePtr _referenceData;
+	ResultCachePtr _resultCache;
+	DecayCachePtr _decayCache;
+	ThreadPoolPtr _requestPool;
+	LatencyStatsPtr _latency;
+};
+
+#endif
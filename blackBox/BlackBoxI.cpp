@@ -0,0 +1,1587 @@
+#include <iostream>
+#include <sstream>
+#include <map>
+#include <algorithm>
+#include "BlackBoxI.h"
+#include "Input.h"
+#include "Output.h"
+#include "FindOptSchedule.h"
+#include "BudgetAllocation.h"
+#include "DecaySampling.h"
+#include "MarkovDecay.h"
+#include "SenStore.h"
+#include "Logger.h"
+
+using namespace std;
+using namespace LCO;
+using namespace SenStore;
+
+/*
+ * Class: ScheduleTask
+ * -------------------------------------------------------
+ * One DP solve, cost or environmental, for a single set of repairs.
+ * The four sub-components of a span are solved as four tasks on the solver pool.
+ * The inputs are only read, so the tasks can share them while the caller waits.
+ */
+class ScheduleTask : public Task {
+public:
+	ScheduleTask(const BridgeInfo& bridge, int ratingsDecay[][10], const RepairEnvMat& repairs, const CostMap& costs, const ImproveMat& impMat, const YearFactors& factors, int limit, bool costObjective, const string& reportFile);
+	virtual void run();
+
+	float minCost;
+	RepairSchedule schedule;
+	bool failed;
+	string reason;
+
+private:
+	const BridgeInfo& _bridge;
+	int (*_ratingsDecay)[10];
+	const RepairEnvMat& _repairs;
+	const CostMap& _costs;
+	const ImproveMat& _impMat;
+	const YearFactors& _factors;
+	int _limit;
+	bool _costObjective;
+	string _reportFile;
+};
+
+typedef IceUtil::Handle<ScheduleTask> ScheduleTaskPtr;
+
+ScheduleTask::ScheduleTask(const BridgeInfo& bridge, int ratingsDecay[][10], const RepairEnvMat& repairs, const CostMap& costs, const ImproveMat& impMat, const YearFactors& factors, int limit, bool costObjective, const string& reportFile) :
+	minCost(0), failed(false), _bridge(bridge), _ratingsDecay(ratingsDecay), _repairs(repairs), _costs(costs),
+	_impMat(impMat), _factors(factors), _limit(limit), _costObjective(costObjective), _reportFile(reportFile)
+{
+}
+
+void 
+ScheduleTask::
+run()
+{
+	try {
+		if (_costObjective)
+			minCost = findOptCostSchedule(_bridge, _ratingsDecay, _repairs, _costs, _impMat, _factors, _limit, schedule, _reportFile);
+		else
+			minCost = findOptEnvSchedule(_bridge, _ratingsDecay, _repairs, _impMat, _factors, _limit, schedule, _reportFile);
+	} catch (const BlackBoxError& ex) {
+		failed = true;
+		reason = ex.reason;
+	} catch (const std::exception& ex) {
+		failed = true;
+		reason = ex.what();
+	}
+}
+
+/*
+ * Class: WeightedTask
+ * -------------------------------------------------------
+ * A ScheduleTask for a weighted sum of the objectives, with the repairs of every objective.
+ */
+class WeightedTask : public Task {
+public:
+	WeightedTask(const BridgeInfo& bridge, int ratingsDecay[][10], const vector<RepairEnvMat>& repairs, const vector<float>& weights, const CostMap& costs, const ImproveMat& impMat, const YearFactors& factors, int limit, const string& reportFile);
+	virtual void run();
+
+	float minCost;
+	RepairSchedule schedule;
+	bool failed;
+	string reason;
+
+private:
+	const BridgeInfo& _bridge;
+	int (*_ratingsDecay)[10];
+	const vector<RepairEnvMat>& _repairs;
+	const vector<float>& _weights;
+	const CostMap& _costs;
+	const ImproveMat& _impMat;
+	const YearFactors& _factors;
+	int _limit;
+	string _reportFile;
+};
+
+typedef IceUtil::Handle<WeightedTask> WeightedTaskPtr;
+
+WeightedTask::WeightedTask(const BridgeInfo& bridge, int ratingsDecay[][10], const vector<RepairEnvMat>& repairs, const vector<float>& weights, const CostMap& costs, const ImproveMat& impMat, const YearFactors& factors, int limit, const string& reportFile) :
+	minCost(0), failed(false), _bridge(bridge), _ratingsDecay(ratingsDecay), _repairs(repairs), _weights(weights), _costs(costs),
+	_impMat(impMat), _factors(factors), _limit(limit), _reportFile(reportFile)
+{
+}
+
+void 
+WeightedTask::
+run()
+{
+	try {
+		minCost = findOptWeightedSchedule(_bridge, _ratingsDecay, _repairs, _weights, _costs, _impMat, _factors, _limit, schedule, _reportFile);
+	} catch (const BlackBoxError& ex) {
+		failed = true;
+		reason = ex.reason;
+	} catch (const std::exception& ex) {
+		failed = true;
+		reason = ex.what();
+	}
+}
+
+/*
+ * Class: FrontTask
+ * -------------------------------------------------------
+ * The Pareto solve of a single set of repairs, one RepairEnvMat per objective.
+ * Like ScheduleTask, the four sub-components of a span are solved as four tasks.
+ */
+class FrontTask : public Task {
+public:
+	FrontTask(const BridgeInfo& bridge, int ratingsDecay[][10], const vector<ParetoObjective>& objectives, const CostMap& costs, const ImproveMat& impMat, const YearFactors& factors, int limit, const string& reportFile);
+	virtual void run();
+
+	ParetoFront front;
+	bool failed;
+	string reason;
+
+private:
+	const BridgeInfo& _bridge;
+	int (*_ratingsDecay)[10];
+	const vector<ParetoObjective>& _objectives;
+	const CostMap& _costs;
+	const ImproveMat& _impMat;
+	const YearFactors& _factors;
+	int _limit;
+	string _reportFile;
+};
+
+typedef IceUtil::Handle<FrontTask> FrontTaskPtr;
+
+FrontTask::FrontTask(const BridgeInfo& bridge, int ratingsDecay[][10], const vector<ParetoObjective>& objectives, const CostMap& costs, const ImproveMat& impMat, const YearFactors& factors, int limit, const string& reportFile) :
+	failed(false), _bridge(bridge), _ratingsDecay(ratingsDecay), _objectives(objectives), _costs(costs),
+	_impMat(impMat), _factors(factors), _limit(limit), _reportFile(reportFile)
+{
+}
+
+void 
+FrontTask::
+run()
+{
+	try {
+		ParetoCostTable table = paretoCostTableCompiler(_bridge, _objectives, _costs, _impMat, _factors, _limit);
+		front = findParetoSchedules(_bridge, _ratingsDecay, table, _limit, _reportFile);
+	} catch (const BlackBoxError& ex) {
+		failed = true;
+		reason = ex.reason;
+	} catch (const std::exception& ex) {
+		failed = true;
+		reason = ex.what();
+	}
+}
+
+/*
+ * Function: sampleOptimum
+ * -------------------------------------------------------
+ * The optimum of a component for one deterioration curve, from the cost tables of its parts;
+ * the schedules of a span are merged by year. No report is written.
+ */
+static float sampleOptimum(const BridgeInfo& bridge, int ratingsDecay[][10], const vector<RepairCostTable>& tables, int limit, bool costObjective, RepairSchedule& optSchedule)
+{
+	float minCost = 0;
+	vector<RepairSchedule> schedules(tables.size());
+	for (int p = 0; p < tables.size(); p++) {
+		if (costObjective)
+			minCost += findOptCostSchedule(bridge, ratingsDecay, tables[p], limit, schedules[p], "");
+		else
+			minCost += findOptEnvSchedule(bridge, ratingsDecay, tables[p], limit, schedules[p], "");
+	}
+	if (tables.size() == 4)
+		optSchedule = mergeFourSched(schedules[0], schedules[1], schedules[2], schedules[3]);
+	else
+		optSchedule.swap(schedules[0]);
+	return minCost;
+}
+
+/*
+ * Class: SampleRun
+ * -------------------------------------------------------
+ * What the tasks of one Monte Carlo solve share. The inputs, and the cost tables built once for
+ * every sample, are only read; sample s writes minimum[s], schedule[s] and solved[s] only.
+ * The samples are handed out by chunks of samplesPerChunk, so a task that is done early takes
+ * the next chunk instead of waiting for the others. Each chunk draws from its own SampleStream,
+ * so the result does not depend on the task that solves it.
+ */
+class SampleRun {
+public:
+	SampleRun(const BridgeInfo& bridge, const DecaySampler& sampler, const vector<RepairCostTable>& tables, int limit, bool costObjective, int seed, int samples);
+
+	// the first sample of the next chunk, -1 once they are all taken
+	int nextChunk();
+
+	static const int samplesPerChunk = 16;
+
+	const BridgeInfo& bridge;
+	const DecaySampler& sampler;
+	const vector<RepairCostTable>& tables;
+	const int limit;
+	const bool costObjective;
+	const int seed;
+	const int samples;
+
+	vector<float> minimum;
+	vector<RepairSchedule> schedule;
+	vector<char> solved;
+
+private:
+	IceUtil::Mutex _mutex;
+	int _next;
+};
+
+SampleRun::SampleRun(const BridgeInfo& bridge, const DecaySampler& sampler, const vector<RepairCostTable>& tables, int limit, bool costObjective, int seed, int samples) :
+	bridge(bridge), sampler(sampler), tables(tables), limit(limit), costObjective(costObjective), seed(seed), samples(samples),
+	minimum(samples, 0.0f), schedule(samples), solved(samples, 0), _next(0)
+{
+}
+
+int 
+SampleRun::
+nextChunk()
+{
+	IceUtil::Mutex::Lock lock(_mutex);
+	if (_next >= samples)
+		return -1;
+	int first = _next;
+	_next += samplesPerChunk;
+	return first;
+}
+
+/*
+ * Class: SampleTask
+ * -------------------------------------------------------
+ * One worker of a Monte Carlo solve: solves chunks of samples until none is left.
+ * A sample whose curve cannot be used, or whose optimum is not finite, stays unsolved.
+ */
+class SampleTask : public Task {
+public:
+	SampleTask(SampleRun& run);
+	virtual void run();
+
+	bool failed;
+	string reason;
+
+private:
+	SampleRun& _run;
+};
+
+typedef IceUtil::Handle<SampleTask> SampleTaskPtr;
+
+SampleTask::SampleTask(SampleRun& run) :
+	failed(false), _run(run)
+{
+}
+
+void 
+SampleTask::
+run()
+{
+	try {
+		int first;
+		while ((first = _run.nextChunk()) >= 0) {
+			SampleStream random(_run.seed, first/SampleRun::samplesPerChunk);
+			int last = min(first + SampleRun::samplesPerChunk, _run.samples);
+			for (int s = first; s < last; s++) {
+				int ratingsDecay[10][10];
+				if (!_run.sampler.sample(random, _run.limit, ratingsDecay))
+					continue;
+				_run.minimum[s] = sampleOptimum(_run.bridge, ratingsDecay, _run.tables, _run.limit, _run.costObjective, _run.schedule[s]);
+				_run.solved[s] = _run.minimum[s] < numeric_limits<float>::infinity();
+			}
+		}
+	} catch (const BlackBoxError& ex) {
+		failed = true;
+		reason = ex.reason;
+	} catch (const std::exception& ex) {
+		failed = true;
+		reason = ex.what();
+	}
+}
+
+
+/*
+ * Class: OptScheduleJob
+ * -------------------------------------------------------
+ * One optSchedule request waiting on the request pool.
+ * Keeps its own copy of the inputs, since the Ice dispatch that created it has already returned.
+ * Its clock starts when it is queued, to time the wait and the whole request.
+ */
+class OptScheduleJob : public Task {
+public:
+	OptScheduleJob(const BlackBoxIPtr& servant, const AMD_BlackBox_optSchedulePtr& cb, const UserInput& userIn, const RepairInfoMat& repairUserIn,
+		const LatencyStatsPtr& latency);
+	virtual void run();
+
+private:
+	BlackBoxIPtr _servant;
+	AMD_BlackBox_optSchedulePtr _cb;
+	UserInput _userIn;
+	RepairInfoMat _repairUserIn;
+	StageClock _clock;
+};
+
+OptScheduleJob::OptScheduleJob(const BlackBoxIPtr& servant, const AMD_BlackBox_optSchedulePtr& cb, const UserInput& userIn, const RepairInfoMat& repairUserIn,
+	const LatencyStatsPtr& latency) :
+	_servant(servant), _cb(cb), _userIn(userIn), _repairUserIn(repairUserIn), _clock(latency, userIn.optObject)
+{
+}
+
+void 
+OptScheduleJob::
+run()
+{
+	_clock.lap(StageQueue);
+	ScheduleResult result;
+	try {
+		result = _servant->solveSchedule(_userIn, _repairUserIn);
+	} catch (const std::exception& ex) {
+		_cb->ice_exception(ex);
+		_clock.stop(StageTotal);
+		return;
+	} catch (...) {
+		_cb->ice_exception();
+		_clock.stop(StageTotal);
+		return;
+	}
+	_cb->ice_response(result);
+	_clock.stop(StageTotal);
+}
+
+/*
+ * Class: FrontJob
+ * -------------------------------------------------------
+ * One optScheduleFront request waiting on the request pool.
+ */
+class FrontJob : public Task {
+public:
+	FrontJob(const BlackBoxIPtr& servant, const AMD_BlackBox_optScheduleFrontPtr& cb, const UserInput& userIn, const ObjectiveSeq& objectives, const RepairInfoMat& repairUserIn);
+	virtual void run();
+
+private:
+	BlackBoxIPtr _servant;
+	AMD_BlackBox_optScheduleFrontPtr _cb;
+	UserInput _userIn;
+	ObjectiveSeq _objectives;
+	RepairInfoMat _repairUserIn;
+};
+
+FrontJob::FrontJob(const BlackBoxIPtr& servant, const AMD_BlackBox_optScheduleFrontPtr& cb, const UserInput& userIn, const ObjectiveSeq& objectives, const RepairInfoMat& repairUserIn) :
+	_servant(servant), _cb(cb), _userIn(userIn), _objectives(objectives), _repairUserIn(repairUserIn)
+{
+}
+
+void 
+FrontJob::
+run()
+{
+	FrontScheduleSeq result;
+	try {
+		result = _servant->solveFront(_userIn, _objectives, _repairUserIn);
+	} catch (const std::exception& ex) {
+		_cb->ice_exception(ex);
+		return;
+	} catch (...) {
+		_cb->ice_exception();
+		return;
+	}
+	_cb->ice_response(result);
+}
+
+/*
+ * Class: WeightedJob
+ * -------------------------------------------------------
+ * One optScheduleWeighted request waiting on the request pool.
+ */
+class WeightedJob : public Task {
+public:
+	WeightedJob(const BlackBoxIPtr& servant, const AMD_BlackBox_optScheduleWeightedPtr& cb, const UserInput& userIn, const ObjectiveValues& weights, const RepairInfoMat& repairUserIn);
+	virtual void run();
+
+private:
+	BlackBoxIPtr _servant;
+	AMD_BlackBox_optScheduleWeightedPtr _cb;
+	UserInput _userIn;
+	ObjectiveValues _weights;
+	RepairInfoMat _repairUserIn;
+};
+
+WeightedJob::WeightedJob(const BlackBoxIPtr& servant, const AMD_BlackBox_optScheduleWeightedPtr& cb, const UserInput& userIn, const ObjectiveValues& weights, const RepairInfoMat& repairUserIn) :
+	_servant(servant), _cb(cb), _userIn(userIn), _weights(weights), _repairUserIn(repairUserIn)
+{
+}
+
+void 
+WeightedJob::
+run()
+{
+	ScheduleResult result;
+	try {
+		result = _servant->solveWeighted(_userIn, _weights, _repairUserIn);
+	} catch (const std::exception& ex) {
+		_cb->ice_exception(ex);
+		return;
+	} catch (...) {
+		_cb->ice_exception();
+		return;
+	}
+	_cb->ice_response(result);
+}
+
+/*
+ * Class: FleetJob
+ * -------------------------------------------------------
+ * One optFleetBudget request waiting on the request pool.
+ */
+class FleetJob : public Task {
+public:
+	FleetJob(const BlackBoxIPtr& servant, const AMD_BlackBox_optFleetBudgetPtr& cb, const ScheduleJobSeq& jobs, const FleetBudget& budget);
+	virtual void run();
+
+private:
+	BlackBoxIPtr _servant;
+	AMD_BlackBox_optFleetBudgetPtr _cb;
+	ScheduleJobSeq _jobs;
+	FleetBudget _budget;
+};
+
+FleetJob::FleetJob(const BlackBoxIPtr& servant, const AMD_BlackBox_optFleetBudgetPtr& cb, const ScheduleJobSeq& jobs, const FleetBudget& budget) :
+	_servant(servant), _cb(cb), _jobs(jobs), _budget(budget)
+{
+}
+
+void 
+FleetJob::
+run()
+{
+	FleetPlan result;
+	try {
+		result = _servant->solveFleet(_jobs, _budget);
+	} catch (const std::exception& ex) {
+		_cb->ice_exception(ex);
+		return;
+	} catch (...) {
+		_cb->ice_exception();
+		return;
+	}
+	_cb->ice_response(result);
+}
+
+/*
+ * Class: FleetBridge
+ * -------------------------------------------------------
+ * The jobs of an optFleetBudget request on one bridge, whose cost frontiers are found in turn
+ * on the solver pool. As in BridgeJobs, the ratings of the bridge are read once and the component
+ * details once per component. Only the entries of frontiers and reasons of this bridge's jobs are
+ * written, so the bridges fill them without locking while the request waits.
+ */
+class FleetBridge : public Task {
+public:
+	FleetBridge(const BlackBoxIPtr& servant, const SenStorePoolPtr& senStore, const ReferenceDataPtr& data, const ScheduleJobSeq& jobs, const vector<int>& bridgeJobs,
+		vector<vector<ConditionFrontier> >& frontiers, vector<string>& reasons);
+	virtual void run();
+
+private:
+	BlackBoxIPtr _servant;
+	SenStorePoolPtr _senStore;
+	ReferenceDataPtr _data;
+	const ScheduleJobSeq& _jobs;
+	vector<int> _bridgeJobs;
+	vector<vector<ConditionFrontier> >& _frontiers;
+	vector<string>& _reasons;
+};
+
+typedef IceUtil::Handle<FleetBridge> FleetBridgePtr;
+
+FleetBridge::FleetBridge(const BlackBoxIPtr& servant, const SenStorePoolPtr& senStore, const ReferenceDataPtr& data, const ScheduleJobSeq& jobs, const vector<int>& bridgeJobs,
+	vector<vector<ConditionFrontier> >& frontiers, vector<string>& reasons) :
+	_servant(servant), _senStore(senStore), _data(data), _jobs(jobs), _bridgeJobs(bridgeJobs), _frontiers(frontiers), _reasons(reasons)
+{
+}
+
+void 
+FleetBridge::
+run()
+{
+	map<int, ServerInput> components;
+	ComponentRatingMat ServerRatings;
+	bool haveRatings = false;
+
+	for (int k = 0; k < _bridgeJobs.size(); k++) {
+		int job = _bridgeJobs[k];
+		const UserInput& userIn = _jobs[job].inputs;
+		try {
+			if (components.find(userIn.componentID) == components.end() || !haveRatings) {
+				SenStoreMngrPrx manager = _senStore->acquire();
+				try {
+					if (components.find(userIn.componentID) == components.end())
+						components[userIn.componentID] = readServerInput(manager, userIn.bridgeID, userIn.componentID);
+					if (!haveRatings) {
+						ServerRatings = _servant->fetchRatings(manager, userIn.bridgeID);
+						haveRatings = true;
+					}
+				} catch (const Ice::LocalException&) {
+					_senStore->invalidate(manager);
+					throw;
+				}
+			}
+
+			_frontiers[job] = _servant->costFrontiers(userIn, _jobs[job].repairs, components[userIn.componentID], ServerRatings, _data);
+		} catch (const BlackBoxError& ex) {
+			_reasons[job] = ex.reason;
+		} catch (const std::exception& ex) {
+			_reasons[job] = ex.what();
+		} catch (const char* msg) {
+			_reasons[job] = msg;
+		} catch (...) {
+			_reasons[job] = "Unknown error";
+		}
+	}
+}
+
+/*
+ * Class: UncertaintyJob
+ * -------------------------------------------------------
+ * One optScheduleUncertainty request waiting on the request pool.
+ */
+class UncertaintyJob : public Task {
+public:
+	UncertaintyJob(const BlackBoxIPtr& servant, const AMD_BlackBox_optScheduleUncertaintyPtr& cb, const UserInput& userIn, const SamplingOptions& sampling, const RepairInfoMat& repairUserIn);
+	virtual void run();
+
+private:
+	BlackBoxIPtr _servant;
+	AMD_BlackBox_optScheduleUncertaintyPtr _cb;
+	UserInput _userIn;
+	SamplingOptions _sampling;
+	RepairInfoMat _repairUserIn;
+};
+
+UncertaintyJob::UncertaintyJob(const BlackBoxIPtr& servant, const AMD_BlackBox_optScheduleUncertaintyPtr& cb, const UserInput& userIn, const SamplingOptions& sampling, const RepairInfoMat& repairUserIn) :
+	_servant(servant), _cb(cb), _userIn(userIn), _sampling(sampling), _repairUserIn(repairUserIn)
+{
+}
+
+void 
+UncertaintyJob::
+run()
+{
+	UncertaintyResult result;
+	try {
+		result = _servant->solveUncertainty(_userIn, _sampling, _repairUserIn);
+	} catch (const std::exception& ex) {
+		_cb->ice_exception(ex);
+		return;
+	} catch (...) {
+		_cb->ice_exception();
+		return;
+	}
+	_cb->ice_response(result);
+}
+
+/*
+ * Class: MarkovJob
+ * -------------------------------------------------------
+ * One optScheduleMarkov request waiting on the request pool.
+ */
+class MarkovJob : public Task {
+public:
+	MarkovJob(const BlackBoxIPtr& servant, const AMD_BlackBox_optScheduleMarkovPtr& cb, const UserInput& userIn, const RepairInfoMat& repairUserIn);
+	virtual void run();
+
+private:
+	BlackBoxIPtr _servant;
+	AMD_BlackBox_optScheduleMarkovPtr _cb;
+	UserInput _userIn;
+	RepairInfoMat _repairUserIn;
+};
+
+MarkovJob::MarkovJob(const BlackBoxIPtr& servant, const AMD_BlackBox_optScheduleMarkovPtr& cb, const UserInput& userIn, const RepairInfoMat& repairUserIn) :
+	_servant(servant), _cb(cb), _userIn(userIn), _repairUserIn(repairUserIn)
+{
+}
+
+void 
+MarkovJob::
+run()
+{
+	MarkovResult result;
+	try {
+		result = _servant->solveMarkov(_userIn, _repairUserIn);
+	} catch (const std::exception& ex) {
+		_cb->ice_exception(ex);
+		return;
+	} catch (...) {
+		_cb->ice_exception();
+		return;
+	}
+	_cb->ice_response(result);
+}
+
+/*
+ * Class: ScheduleBatch
+ * -------------------------------------------------------
+ * State shared by the tasks of one optScheduleBatch call: the jobs, the reference data
+ * snapshot they all use, and the count of results sent to the observer.
+ * The observer is told batchFinished once the last group of jobs is done. It is called
+ * oneway, so a slow or unreachable client never holds a worker of the request pool.
+ */
+class ScheduleBatch : public IceUtil::Shared {
+public:
+	ScheduleBatch(const ScheduleJobSeq& jobs, const ScheduleObserverPrx& observer, const ReferenceDataPtr& data, int groups);
+
+	void jobFinished(int job, const ScheduleResult& result);
+	void jobFailed(int job, const string& reason);
+	void groupFinished();
+
+	const ScheduleJobSeq jobs;
+	const ReferenceDataPtr data;
+
+private:
+	void observerFailed(const Ice::Exception& ex);
+
+	IceUtil::Mutex _mutex;
+	ScheduleObserverPrx _observer;
+	int _groups;
+	int _succeeded;
+	int _failed;
+};
+
+typedef IceUtil::Handle<ScheduleBatch> ScheduleBatchPtr;
+
+ScheduleBatch::ScheduleBatch(const ScheduleJobSeq& jobs, const ScheduleObserverPrx& observer, const ReferenceDataPtr& data, int groups) :
+	jobs(jobs), data(data), _observer(ScheduleObserverPrx::uncheckedCast(observer->ice_oneway())), _groups(groups), _succeeded(0), _failed(0)
+{
+}
+
+void 
+ScheduleBatch::
+jobFinished(int job, const ScheduleResult& result)
+{
+	{
+		IceUtil::Mutex::Lock lock(_mutex);
+		_succeeded++;
+	}
+	try {
+		_observer->jobFinished(job, result);
+	} catch (const Ice::Exception& ex) {
+		observerFailed(ex);
+	}
+}
+
+void 
+ScheduleBatch::
+jobFailed(int job, const string& reason)
+{
+	{
+		IceUtil::Mutex::Lock lock(_mutex);
+		_failed++;
+	}
+	try {
+		_observer->jobFailed(job, reason);
+	} catch (const Ice::Exception& ex) {
+		observerFailed(ex);
+	}
+}
+
+void 
+ScheduleBatch::
+groupFinished()
+{
+	int succeeded, failed;
+	{
+		IceUtil::Mutex::Lock lock(_mutex);
+		if (--_groups > 0)
+			return;
+		succeeded = _succeeded;
+		failed = _failed;
+	}
+	try {
+		_observer->batchFinished(succeeded, failed);
+	} catch (const Ice::Exception& ex) {
+		observerFailed(ex);
+	}
+}
+
+/*
+ * Implementation: observerFailed
+ * -------------------------------------------------------
+ * The results are also stored in SenStore, so the batch goes on without its observer. A oneway
+ * call only fails if the request cannot be sent.
+ */
+void 
+ScheduleBatch::
+observerFailed(const Ice::Exception& ex)
+{
+	LOG_WARNING("Batch observer not reached: " << ex);
+}
+
+/*
+ * Class: BridgeJobs
+ * -------------------------------------------------------
+ * The jobs of a batch on one bridge, solved in turn on the request pool. The ratings of
+ * the bridge are read once and the component details once per component.
+ */
+class BridgeJobs : public Task {
+public:
+	BridgeJobs(const BlackBoxIPtr& servant, const SenStorePoolPtr& senStore, const ScheduleBatchPtr& batch, const vector<int>& jobs);
+	virtual void run();
+
+private:
+	BlackBoxIPtr _servant;
+	SenStorePoolPtr _senStore;
+	ScheduleBatchPtr _batch;
+	vector<int> _jobs;
+};
+
+BridgeJobs::BridgeJobs(const BlackBoxIPtr& servant, const SenStorePoolPtr& senStore, const ScheduleBatchPtr& batch, const vector<int>& jobs) :
+	_servant(servant), _senStore(senStore), _batch(batch), _jobs(jobs)
+{
+}
+
+void 
+BridgeJobs::
+run()
+{
+	map<int, ServerInput> components;
+	ComponentRatingMat ServerRatings;
+	bool haveRatings = false;
+
+	for (int k = 0; k < _jobs.size(); k++) {
+		int job = _jobs[k];
+		const ScheduleJob& scheduleJob = _batch->jobs[job];
+		const UserInput& userIn = scheduleJob.inputs;
+		try {
+			SenStoreMngrPrx manager = _senStore->acquire();
+			try {
+				if (components.find(userIn.componentID) == components.end())
+					components[userIn.componentID] = readServerInput(manager, userIn.bridgeID, userIn.componentID);
+				if (!haveRatings) {
+					ServerRatings = _servant->fetchRatings(manager, userIn.bridgeID);
+					haveRatings = true;
+				}
+			} catch (const Ice::LocalException&) {
+				_senStore->invalidate(manager);
+				throw;
+			}
+
+			ScheduleResult result = _servant->solveSchedule(userIn, scheduleJob.repairs, components[userIn.componentID], ServerRatings, _batch->data, manager);
+			_batch->jobFinished(job, result);
+		} catch (const BlackBoxError& ex) {
+			_batch->jobFailed(job, ex.reason);
+		} catch (const std::exception& ex) {
+			_batch->jobFailed(job, ex.what());
+		} catch (const char* msg) {
+			_batch->jobFailed(job, msg);
+		} catch (...) {
+			_batch->jobFailed(job, "Unknown error");
+		}
+	}
+	_batch->groupFinished();
+}
+
+/*
+ * Class: BatchJob
+ * -------------------------------------------------------
+ * An optScheduleBatch request waiting on the request pool. When it runs it groups the jobs
+ * by bridge and queues one BridgeJobs per bridge, so the bridges are solved in parallel.
+ */
+class BatchJob : public Task {
+public:
+	BatchJob(const BlackBoxIPtr& servant, const ThreadPoolPtr& requestPool, const SenStorePoolPtr& senStore, const ReferenceDataPtr& data,
+		const ScheduleJobSeq& jobs, const ScheduleObserverPrx& observer);
+	virtual void run();
+
+private:
+	BlackBoxIPtr _servant;
+	ThreadPoolPtr _requestPool;
+	SenStorePoolPtr _senStore;
+	ReferenceDataPtr _data;
+	ScheduleJobSeq _jobs;
+	ScheduleObserverPrx _observer;
+};
+
+BatchJob::BatchJob(const BlackBoxIPtr& servant, const ThreadPoolPtr& requestPool, const SenStorePoolPtr& senStore, const ReferenceDataPtr& data,
+	const ScheduleJobSeq& jobs, const ScheduleObserverPrx& observer) :
+	_servant(servant), _requestPool(requestPool), _senStore(senStore), _data(data), _jobs(jobs), _observer(observer)
+{
+}
+
+void 
+BatchJob::
+run()
+{
+	// jobs of each bridge, in the order of the batch
+	map<int, vector<int> > bridges;
+	for (int job = 0; job < _jobs.size(); job++)
+		bridges[_jobs[job].inputs.bridgeID].push_back(job);
+
+	// an empty batch is reported as one empty group
+	ScheduleBatchPtr batch = new ScheduleBatch(_jobs, _observer, _data, max((int)bridges.size(), 1));
+	if (bridges.empty()) {
+		batch->groupFinished();
+		return;
+	}
+
+	for (map<int, vector<int> >::const_iterator bridge = bridges.begin(); bridge != bridges.end(); ++bridge) {
+		TaskPtr group = new BridgeJobs(_servant, _senStore, batch, bridge->second);
+		// the batch was admitted as a whole; the pool only refuses when it is shutting down
+		if (!_requestPool->submitAdmitted(group))
+			group->execute();
+	}
+}
+
+static IceUtil::StaticMutex reportMutex = ICE_STATIC_MUTEX_INITIALIZER;
+static int reports = 0;
+
+/*
+ * Function: reportNumber
+ * -------------------------------------------------------
+ * Number of a request among those solved since the server started, for the report
+ * files of identical concurrent requests to be told apart.
+ */
+static int reportNumber()
+{
+	IceUtil::StaticMutex::Lock lock(reportMutex);
+	return ++reports;
+}
+
+/*
+ * Function: reportName
+ * -------------------------------------------------------
+ * Name of a report file of request "number", solving "solve". No two concurrent
+ * requests write to the same file, whether for the same component and objective or not.
+ */
+static string reportName(const UserInput& userIn, const string& solve, int number, const string& part)
+{
+	ostringstream name;
+	name << "Optimal Maintenance Schedule " << userIn.bridgeID << "-" << userIn.componentID << " " << solve << " " << number;
+	if (!part.empty())
+		name << " " << part;
+	return name.str();
+}
+
+/*
+ * Function: componentParts
+ * -------------------------------------------------------
+ * Repair types planned for a component: the four sub-components of a span, or the one of
+ * any other component.
+ */
+static vector<string> componentParts(StructureComponentType componentType)
+{
+	vector<string> parts;
+	switch(componentType) {
+		case StructureComponentTypeDeck:
+			LOG_DEBUG("The selected component is StructureComponentTypeDECK");
+			parts.push_back("Deck");
+			break;
+		case StructureComponentTypeAbutment:
+			LOG_DEBUG("The selected component is StructureComponentTypeABUTMENT");
+			parts.push_back("Foundation");
+			break;
+		case StructureComponentTypePinHanger:
+			LOG_DEBUG("The selected component is StructureComponentTypePINHANGER");
+			parts.push_back("PinHanger");
+			break;
+		case StructureComponentTypeSpan:
+			LOG_DEBUG("The selected component is StructureComponentTypeSPAN");
+			parts.push_back("Deck");
+			parts.push_back("Barrier");
+			parts.push_back("Joint");
+			parts.push_back("Other");
+			break;
+		case StructureComponentTypeColumn:
+			LOG_DEBUG("The selected component is StructureComponentTypeCOLUMN");
+			parts.push_back("Column");
+			break;
+		default:
+			throw BlackBoxError("Unidentified ComponentType");
+	}
+	return parts;
+}
+
+/*
+ * Function: improveCoefficients
+ * -------------------------------------------------------
+ * Improvement coefficients of conditions 4 to 6.
+ */
+static ImproveMat improveCoefficients()
+{
+	ImproveMat impMat;
+	ImpCoef cond4;
+	cond4.condition = 4;
+	cond4.coef = 0.15;
+
+	ImpCoef cond5;
+	cond5.condition = 5;
+	cond5.coef = 0.1;
+
+	ImpCoef cond6;
+	cond6.condition = 6;
+	cond6.coef = 0.05;
+
+	impMat.push_back(cond4);
+	impMat.push_back(cond5);
+	impMat.push_back(cond6);
+	return impMat;
+}
+
+/*
+ * Function: costTables
+ * -------------------------------------------------------
+ * The cost table of every part of a component for objective optObj, built once for solves
+ * that run the DP many times or under another deterioration model.
+ */
+static vector<RepairCostTable> costTables(const BridgeInfo& bridge, const RepairInfoMat& repairUserIn, const vector<string>& parts, const ReferenceDataPtr& data, int optObj,
+	const CostMap& costs, const ImproveMat& impMat, const YearFactors& factors, int limit)
+{
+	vector<RepairCostTable> tables(parts.size());
+	for (int p = 0; p < parts.size(); p++) {
+		RepairEnvMat repairs = envInfoCompiler(repairUserIn, parts[p], data->basicInfo(), data->envCoef(optObj), data->catalog(optObj));
+		if (optObj == 11)
+			tables[p] = costTableCompiler(bridge, repairs, costs, impMat, factors, limit);
+		else
+			tables[p] = envCostTableCompiler(bridge, repairs, impMat, factors, limit);
+	}
+	return tables;
+}
+
+/*
+ * Function: solveParts
+ * -------------------------------------------------------
+ * Solves the tasks of one request, such as the parts of a component: the extra ones are handed to
+ * the solver pool and the first one is solved on this thread. Throws the error of the first task that failed.
+ */
+template <class TaskPtrType>
+static void solveParts(const ThreadPoolPtr& solverPool, const vector<TaskPtrType>& tasks)
+{
+	for (int i = 1; i < tasks.size(); i++) {
+		if (!solverPool->submit(tasks[i]))
+			tasks[i]->execute();
+	}
+	tasks[0]->execute();
+	for (int i = 0; i < tasks.size(); i++)
+		tasks[i]->wait();
+	for (int i = 0; i < tasks.size(); i++) {
+		if (tasks[i]->failed)
+			throw BlackBoxError(tasks[i]->reason);
+	}
+}
+
+/*
+ * Function: scheduleResult
+ * -------------------------------------------------------
+ * The optimum of a component and its schedule as they are returned to the client.
+ */
+static ScheduleResult scheduleResult(float minCost, const RepairSchedule& optSchedule)
+{
+	ScheduleResult result;
+	result.minimum = minCost;
+	for (int i = 0; i < optSchedule.size(); i++) {
+		ScheduledRepair repair;
+		repair.repairID = optSchedule[i].repairID;
+		repair.year = optSchedule[i].repairYear;
+		repair.value = optSchedule[i].value;
+		result.schedule.push_back(repair);
+	}
+	return result;
+}
+
+/*
+ * Function: scheduleResult
+ * -------------------------------------------------------
+ * The optimum of a component from the tasks of its parts; the schedules of a span are merged by year.
+ */
+template <class TaskPtrType>
+static ScheduleResult scheduleResult(const vector<TaskPtrType>& tasks)
+{
+	float minCost = tasks[0]->minCost;
+	RepairSchedule optSchedule = tasks[0]->schedule;
+	if (tasks.size() == 4) {
+		minCost = minCost + tasks[1]->minCost + tasks[2]->minCost + tasks[3]->minCost;
+		optSchedule = mergeFourSched(tasks[0]->schedule, tasks[1]->schedule, tasks[2]->schedule, tasks[3]->schedule);
+	}
+	return scheduleResult(minCost, optSchedule);
+}
+
+/*
+ * Function: frontierResult
+ * -------------------------------------------------------
+ * The schedule of a component ending in "finalRating", from the cost frontiers of its parts.
+ */
+static ScheduleResult frontierResult(const vector<ConditionFrontier>& parts, int finalRating)
+{
+	vector<ConditionSchedule> conditions(parts.size());
+	for (int p = 0; p < parts.size(); p++) {
+		for (int k = 0; k < parts[p].size(); k++) {
+			if (parts[p][k].finalRating == finalRating)
+				conditions[p] = parts[p][k];
+		}
+	}
+
+	float minCost = conditions[0].minimum;
+	RepairSchedule optSchedule = conditions[0].schedule;
+	if (conditions.size() == 4) {
+		minCost = minCost + conditions[1].minimum + conditions[2].minimum + conditions[3].minimum;
+		optSchedule = mergeFourSched(conditions[0].schedule, conditions[1].schedule, conditions[2].schedule, conditions[3].schedule);
+	}
+	return scheduleResult(minCost, optSchedule);
+}
+
+BlackBoxI::BlackBoxI(const ThreadPoolPtr& requestPool, const ThreadPoolPtr& solverPool, const SenStorePoolPtr& senStore, const ReferenceDataStorePtr& referenceData,
+	const DecayCachePtr& decayCache, const ResultCachePtr& resultCache, const LatencyStatsPtr& latency) :
+	_requestPool(requestPool), _solverPool(solverPool), _senStore(senStore), _referenceData(referenceData), _decayCache(decayCache),
+	_resultCache(resultCache), _latency(latency)
+{
+}
+
+void 
+BlackBoxI::
+optSchedule_async(const AMD_BlackBox_optSchedulePtr& cb, const UserInput& userIn, const ComponentRatingMat& ratings, const RepairInfoMat& repairUserIn, const ::Ice::Current&)
+{
+	TaskPtr job = new OptScheduleJob(this, cb, userIn, repairUserIn, _latency);
+	if (!_requestPool->submit(job))
+		cb->ice_exception(BlackBoxBusy("The server is busy, too many optimizations are waiting"));
+}
+
+void 
+BlackBoxI::
+optScheduleBatch(const ScheduleJobSeq& jobs, const ScheduleObserverPrx& observer, const ::Ice::Current&)
+{
+	if (!observer)
+		throw BlackBoxError("A batch needs an observer for its results");
+
+	// every job of the batch uses the reference data of the time it was submitted
+	TaskPtr batch = new BatchJob(this, _requestPool, _senStore, _referenceData->current(), jobs, observer);
+	if (!_requestPool->submit(batch))
+		throw BlackBoxBusy("The server is busy, too many optimizations are waiting");
+}
+
+void 
+BlackBoxI::
+optScheduleFront_async(const AMD_BlackBox_optScheduleFrontPtr& cb, const UserInput& userIn, const ObjectiveSeq& objectives, const ComponentRatingMat& ratings, const RepairInfoMat& repairUserIn, const ::Ice::Current&)
+{
+	TaskPtr job = new FrontJob(this, cb, userIn, objectives, repairUserIn);
+	if (!_requestPool->submit(job))
+		cb->ice_exception(BlackBoxBusy("The server is busy, too many optimizations are waiting"));
+}
+
+void 
+BlackBoxI::
+optScheduleWeighted_async(const AMD_BlackBox_optScheduleWeightedPtr& cb, const UserInput& userIn, const ObjectiveValues& weights, const ComponentRatingMat& ratings, const RepairInfoMat& repairUserIn, const ::Ice::Current&)
+{
+	TaskPtr job = new WeightedJob(this, cb, userIn, weights, repairUserIn);
+	if (!_requestPool->submit(job))
+		cb->ice_exception(BlackBoxBusy("The server is busy, too many optimizations are waiting"));
+}
+
+void 
+BlackBoxI::
+optFleetBudget_async(const AMD_BlackBox_optFleetBudgetPtr& cb, const ScheduleJobSeq& jobs, const FleetBudget& budget, const ::Ice::Current&)
+{
+	TaskPtr job = new FleetJob(this, cb, jobs, budget);
+	if (!_requestPool->submit(job))
+		cb->ice_exception(BlackBoxBusy("The server is busy, too many optimizations are waiting"));
+}
+
+void 
+BlackBoxI::
+optScheduleUncertainty_async(const AMD_BlackBox_optScheduleUncertaintyPtr& cb, const UserInput& userIn, const SamplingOptions& sampling, const ComponentRatingMat& ratings, const RepairInfoMat& repairUserIn, const ::Ice::Current&)
+{
+	TaskPtr job = new UncertaintyJob(this, cb, userIn, sampling, repairUserIn);
+	if (!_requestPool->submit(job))
+		cb->ice_exception(BlackBoxBusy("The server is busy, too many optimizations are waiting"));
+}
+
+void 
+BlackBoxI::
+optScheduleMarkov_async(const AMD_BlackBox_optScheduleMarkovPtr& cb, const UserInput& userIn, const ComponentRatingMat& ratings, const RepairInfoMat& repairUserIn, const ::Ice::Current&)
+{
+	TaskPtr job = new MarkovJob(this, cb, userIn, repairUserIn);
+	if (!_requestPool->submit(job))
+		cb->ice_exception(BlackBoxBusy("The server is busy, too many optimizations are waiting"));
+}
+
+/*
+ * Implementation: fetchServerInputs
+ * -------------------------------------------------------
+ * Reads the component details and the ratings of the bridge kept in SenStore.
+ * Returns the proxy they were read with, for the results to be written with it.
+ */
+SenStoreMngrPrx 
+BlackBoxI::
+fetchServerInputs(const UserInput& userIn, ServerInput& serverIn, ComponentRatingMat& ServerRatings)
+{
+	SenStoreMngrPrx manager = _senStore->acquire();
+	try {
+		serverIn = readServerInput(manager, userIn.bridgeID, userIn.componentID);
+		ServerRatings = fetchRatings(manager, userIn.bridgeID); // Commented to use the ratings from userInput
+	} catch (const Ice::LocalException&) {
+		_senStore->invalidate(manager);
+		throw;
+	}
+	return manager;
+}
+
+/*
+ * Implementation: fetchRatings
+ * -------------------------------------------------------
+ * The ratings are those of component 1 of the bridge, whichever component is solved.
+ */
+ComponentRatingMat 
+BlackBoxI::
+fetchRatings(const SenStoreMngrPrx& manager, int bridgeID)
+{
+	return _decayCache->ratings(manager, bridgeID, 1);
+}
+
+/*
+ * Implementation: ratingDecay
+ * -------------------------------------------------------
+ * ratingDecay of the ratings, through the decay cache.
+ */
+void 
+BlackBoxI::
+ratingDecay(int ratingsDecay[][10], const UserInput& userIn, const ComponentRatingMat& ServerRatings)
+{
+	_decayCache->ratingDecay(ratingsDecay, userIn.bridgeID, userIn.componentID, ServerRatings, userIn.ratingLowerLimit);
+}
+
+/*
+ * Implementation: solveSchedule
+ * -------------------------------------------------------
+ * The former body of the synchronous optSchedule: fetch the inputs kept in SenStore, then solve.
+ * The generation of the ratings is taken before they are fetched, so a result stored under it
+ * is never newer than the ratings it was solved with.
+ */
+ScheduleResult 
+BlackBoxI::
+solveSchedule(const UserInput& userIn, const RepairInfoMat& repairUserIn)
+{	
+	ReferenceDataPtr data = _referenceData->current();
+	int generation = _decayCache->generation();
+	ScheduleResult result;
+	if (_resultCache->find(userIn, repairUserIn, data->version(), generation, result))
+		return result;
+
+	/* Server Input */
+	StageClock clock(_latency, userIn.optObject);
+	ServerInput serverIn;	
+	ComponentRatingMat ServerRatings;
+	SenStoreMngrPrx manager = fetchServerInputs(userIn, serverIn, ServerRatings);
+	clock.lap(StageFetch);
+	result = solveSchedule(userIn, repairUserIn, serverIn, ServerRatings, data, manager);
+	_resultCache->store(userIn, repairUserIn, data->version(), generation, result);
+	return result;
+}
+
+/*
+ * Implementation: solveSchedule
+ * -------------------------------------------------------
+ * Solve with inputs that were already fetched, as a batch does for the jobs of one bridge.
+ * The stages from the fit to the write are timed.
+ */
+ScheduleResult 
+BlackBoxI::
+solveSchedule(const UserInput& userIn, const RepairInfoMat& repairUserIn, const ServerInput& serverIn, const ComponentRatingMat& ServerRatings, const ReferenceDataPtr& data, const SenStoreMngrPrx& manager)
+{	
+	int optObj = userIn.optObject;
+	OptimizationObjective objective = (OptimizationObjective)(optObj -1);
+	EnvImpactType impactType = findEnvImpactType(optObj);
+	Unit unit = findUnit(optObj);
+	int limit = userIn.ratingLowerLimit;
+	StageClock clock(_latency, optObj);
+
+	//ratingsdecay[x][y] is the years taken for rating "x" decreasing to "y" witout maintenance
+	int ratingsDecay[10][10];
+	ratingDecay(ratingsDecay, userIn, ServerRatings);
+	clock.lap(StageFit);
+	BridgeInfo bridge = bridgeInfoCompiler(userIn, serverIn);
+	CostMap costs = readRepairCost(repairUserIn);
+	YearFactors factors = yearFactorsCompiler(bridge, bridge.nYears);
+
+	ImproveMat impMat = improveCoefficients();
+
+	/* prepare envMat */
+	// the snapshot is held until the request ends, a reload meanwhile does not affect it
+	const RepairBasicInfoMat& repairs = data->basicInfo();
+	//cout << repairs.size() << endl;
+	
+	const EnvCoefMat& envCos = data->envCoef(optObj);
+	const RepairCatalog& catalog = data->catalog(optObj);
+
+	//RepairEnvMat envMat;
+	//string type = "joint";	
+	//envMat = envInfoCompiler(repairUserIn, type, repairs, envCos);
+
+	//RepairSchedule optSchedule;
+	//findOptEnvSchedule(bridge, ratingsDecay, envMat, impMat, limit, optSchedule);
+	////findOptCostSchedule(bridge, ratingsDecay, envMat, costs, impMat, limit, optSchedule);
+	//cout << "Success" << endl;
+	
+	vector<string> parts = componentParts(serverIn.componentType);
+	vector<RepairEnvMat> envMats(parts.size());
+	for (int p = 0; p < parts.size(); p++)
+		envMats[p] = envInfoCompiler(repairUserIn, parts[p], repairs, envCos, catalog);
+
+	//date
+	double date = sysDate();
+
+	bool costObjective = (optObj == 11);
+	ostringstream solve;
+	solve << "objective " << optObj;
+	int number = reportNumber();
+	vector<ScheduleTaskPtr> tasks;
+	for (int p = 0; p < parts.size(); p++) {
+		string part = parts.size() > 1 ? parts[p] : "";
+		tasks.push_back(new ScheduleTask(bridge, ratingsDecay, envMats[p], costs, impMat, factors, limit, costObjective, reportName(userIn, solve.str(), number, part)));
+	}
+
+	clock.lap(StageCompile);
+
+	// hand the extra sub-schedules to the pool and solve the first one on this thread
+	solveParts(_solverPool, tasks);
+	IceUtil::Time dp = clock.lap(StageDP);
+	ScheduleResult result = scheduleResult(tasks);
+	float minCost = result.minimum;
+	clock.lap(StageMerge);
+
+	if (writeToServer(manager, userIn.bridgeID, userIn.componentID, objective, date, impactType, unit, minCost) != 0
+		|| writeScheduleToServer(manager, userIn.bridgeID, userIn.componentID, objective, date, result.schedule) != 0)
+		_senStore->invalidate(manager);
+	clock.lap(StageWrite);
+
+	LOG_DEBUG("Computational Cost:" << dp.toSecondsDouble());
+	return result;
+}
+
+/*
+ * Implementation: solveFront
+ * -------------------------------------------------------
+ * The inputs are prepared as in solveSchedule, with the repairs of every objective, and each
+ * part of the component is solved once for all of them.
+ */
+FrontScheduleSeq 
+BlackBoxI::
+solveFront(const UserInput& userIn, const ObjectiveSeq& objectives, const RepairInfoMat& repairUserIn)
+{
+	if (objectives.empty())
+		throw BlackBoxError("No objective to optimize");
+
+	ServerInput serverIn;
+	ComponentRatingMat ServerRatings;
+	fetchServerInputs(userIn, serverIn, ServerRatings);
+	ReferenceDataPtr data = _referenceData->current();
+
+	int limit = userIn.ratingLowerLimit;
+	int ratingsDecay[10][10];
+	ratingDecay(ratingsDecay, userIn, ServerRatings);
+	BridgeInfo bridge = bridgeInfoCompiler(userIn, serverIn);
+	CostMap costs = readRepairCost(repairUserIn);
+	YearFactors factors = yearFactorsCompiler(bridge, bridge.nYears);
+	ImproveMat impMat = improveCoefficients();
+
+	vector<string> parts = componentParts(serverIn.componentType);
+	// the tasks only borrow the objectives of their part, so they are kept here until the tasks end
+	vector<vector<ParetoObjective> > paretoObjectives(parts.size(), vector<ParetoObjective>(objectives.size()));
+	vector<FrontTaskPtr> tasks;
+	int number = reportNumber();
+	for (int p = 0; p < parts.size(); p++) {
+		for (int o = 0; o < objectives.size(); o++) {
+			paretoObjectives[p][o].repairs = envInfoCompiler(repairUserIn, parts[p], data->basicInfo(), data->envCoef(objectives[o]), data->catalog(objectives[o]));
+			paretoObjectives[p][o].cost = (objectives[o] == 11);
+		}
+		string part = parts.size() > 1 ? parts[p] : "";
+		tasks.push_back(new FrontTask(bridge, ratingsDecay, paretoObjectives[p], costs, impMat, factors, limit, reportName(userIn, "Pareto", number, part)));
+	}
+
+	solveParts(_solverPool, tasks);
+
+	ParetoFront front = tasks[0]->front;
+	if (tasks.size() == 4)
+		front = mergeFourFronts(tasks[0]->front, tasks[1]->front, tasks[2]->front, tasks[3]->front);
+
+	FrontScheduleSeq result;
+	for (int f = 0; f < front.size(); f++) {
+		FrontSchedule point;
+		point.minimum = front[f].minimum;
+		for (int i = 0; i < front[f].repairs.size(); i++) {
+			FrontRepair repair;
+			repair.repairID = front[f].repairs[i].repairID;
+			repair.year = front[f].repairs[i].repairYear;
+			repair.values = front[f].repairs[i].values;
+			point.schedule.push_back(repair);
+		}
+		result.push_back(point);
+	}
+	return result;
+}
+
+/*
+ * Implementation: solveWeighted
+ * -------------------------------------------------------
+ * As solveFront, with the repairs of the objectives that have a weight.
+ */
+ScheduleResult 
+BlackBoxI::
+solveWeighted(const UserInput& userIn, const ObjectiveValues& weights, const RepairInfoMat& repairUserIn)
+{
+	// weights[o] is the weight of optObject o+1
+	const int numObjectives = 11;
+	if (weights.size() != numObjectives)
+		throw BlackBoxError("One weight is needed for every objective");
+
+	ServerInput serverIn;
+	ComponentRatingMat ServerRatings;
+	fetchServerInputs(userIn, serverIn, ServerRatings);
+	ReferenceDataPtr data = _referenceData->current();
+
+	int limit = userIn.ratingLowerLimit;
+	int ratingsDecay[10][10];
+	ratingDecay(ratingsDecay, userIn, ServerRatings);
+	BridgeInfo bridge = bridgeInfoCompiler(userIn, serverIn);
+	CostMap costs = readRepairCost(repairUserIn);
+	YearFactors factors = yearFactorsCompiler(bridge, bridge.nYears);
+	ImproveMat impMat = improveCoefficients();
+
+	vector<string> parts = componentParts(serverIn.componentType);
+	// the tasks only borrow the repairs of their part, so they are kept here until the tasks end
+	vector<vector<RepairEnvMat> > repairs(parts.size(), vector<RepairEnvMat>(numObjectives));
+	vector<WeightedTaskPtr> tasks;
+	int number = reportNumber();
+	for (int p = 0; p < parts.size(); p++) {
+		for (int o = 0; o < numObjectives; o++) {
+			if (weights[o] != 0)
+				repairs[p][o] = envInfoCompiler(repairUserIn, parts[p], data->basicInfo(), data->envCoef(o+1), data->catalog(o+1));
+		}
+		string part = parts.size() > 1 ? parts[p] : "";
+		tasks.push_back(new WeightedTask(bridge, ratingsDecay, repairs[p], weights, costs, impMat, factors, limit, reportName(userIn, "Weighted", number, part)));
+	}
+
+	solveParts(_solverPool, tasks);
+	return scheduleResult(tasks);
+}
+
+/*
+ * Implementation: solveMarkov
+ * -------------------------------------------------------
+ * The inputs and cost tables are those of solveSchedule; the value iteration of a part is
+ * cheap next to building its table, so the parts are solved in turn on this thread.
+ */
+MarkovResult 
+BlackBoxI::
+solveMarkov(const UserInput& userIn, const RepairInfoMat& repairUserIn)
+{
+	ServerInput serverIn;
+	ComponentRatingMat ServerRatings;
+	fetchServerInputs(userIn, serverIn, ServerRatings);
+	ReferenceDataPtr data = _referenceData->current();
+
+	int optObj = userIn.optObject;
+	int limit = userIn.ratingLowerLimit;
+	BridgeInfo bridge = bridgeInfoCompiler(userIn, serverIn);
+	CostMap costs = readRepairCost(repairUserIn);
+	YearFactors factors = yearFactorsCompiler(bridge, bridge.nYears);
+	ImproveMat impMat = improveCoefficients();
+
+	if (bridge.startRating < limit || bridge.startRating >= bridge.nRatings)
+		throw BlackBoxError("The start rating must be within the rating scale and not below the lower limit");
+
+	MarkovModel model = markovModelCompiler(ServerRatings, bridge.nRatings);
+	vector<string> parts = componentParts(serverIn.componentType);
+	vector<RepairCostTable> tables = costTables(bridge, repairUserIn, parts, data, optObj, costs, impMat, factors, limit);
+
+	MarkovResult result;
+	result.expected = 0;
+	result.ratingLevels = bridge.nRatings;
+	result.stay = model.stay;
+	for (int p = 0; p < parts.size(); p++) {
+		MarkovPolicy policy = markovValueIteration(model, tables[p], limit);
+		PartPolicy part;
+		part.part = parts[p];
+		part.expected = policy.value[bridge.startRating];
+		part.repairID = policy.repairID;
+		part.target = policy.target;
+		result.expected += part.expected;
+		result.parts.push_back(part);
+	}
+	return result;
+}
+
+/*
+ * Implementation: solveFleet
+ * -------------------------------------------------------
+ * The frontiers are the expensive part, one DP per part of every component; the allocation
+ * only compares their options, so it runs on this thread once they are all found.
+ */
+FleetPlan 
+BlackBoxI::
+solveFleet(const ScheduleJobSeq& jobs, const FleetBudget& budget)
+{
+	if (budget.budgets.empty())
+		throw BlackBoxError("The budget has no year");
+	for (int y = 0; y < budget.budgets.size(); y++) {
+		if (budget.budgets[y] < 0)
+			throw BlackBoxError("A yearly budget cannot be negative");
+	}
+
+	// every job uses the reference data of the time the request started
+	ReferenceDataPtr data = _referenceData->current();
+
+	map<int, vector<int> > bridges;
+	for (int job = 0; job < jobs.size(); job++)
+		bridges[jobs[job].inputs.bridgeID].push_back(job);
+
+	vector<vector<ConditionFrontier> > frontiers(jobs.size());
+	vector<string> reasons(jobs.size());
+	vector<FleetBridgePtr> tasks;
+	for (map<int, vector<int> >::const_iterator bridge = bridges.begin(); bridge != bridges.end(); ++bridge) {
+		FleetBridgePtr task = new FleetBridge(this, _senStore, data, jobs, bridge->second, frontiers, reasons);
+		tasks.push_back(task);
+		if (!_solverPool->submit(task))
+			task->execute();
+	}
+	for (int i = 0; i < tasks.size(); i++)
+		tasks[i]->wait();
+
+	vector<FleetComponent> components(jobs.size());
+	for (int job = 0; job < jobs.size(); job++) {
+		if (!reasons[job].empty())
+			continue;
+		components[job] = fleetComponent(frontiers[job], budget.startYear, budget.budgets.size());
+		if (components[job].options.empty())
+			reasons[job] = "No final condition is reached by every part of the component";
+	}
+
+	FleetAllocation allocation = allocateBudget(components, budget.budgets);
+
+	FleetPlan plan;
+	plan.spent = allocation.spent;
+	plan.withinBudget = allocation.withinBudget;
+	for (int job = 0; job < jobs.size(); job++) {
+		FleetChoice choice;
+		choice.job = job;
+		choice.finalRating = -1;
+		choice.result.minimum = 0;
+		choice.reason = reasons[job];
+		if (allocation.choice[job] >= 0) {
+			choice.finalRating = components[job].options[allocation.choice[job]].finalRating;
+			choice.result = frontierResult(frontiers[job], choice.finalRating);
+		}
+		plan.choices.push_back(choice);
+	}
+	return plan;
+}
+
+/*
+ * Implementation: costFrontiers
+ * -------------------------------------------------------
+ * The inputs are prepared as in solveSchedule for optObject 11, whatever the job asked for.
+ */
+vector<ConditionFrontier> 
+BlackBoxI::
+costFrontiers(const UserInput& userIn, const RepairInfoMat& repairUserIn, const ServerInput& serverIn, const ComponentRatingMat& ServerRatings, const ReferenceDataPtr& data)
+{
+	const int costObject = 11;
+	int limit = userIn.ratingLowerLimit;
+	int ratingsDecay[10][10];
+	ratingDecay(ratingsDecay, userIn, ServerRatings);
+	BridgeInfo bridge = bridgeInfoCompiler(userIn, serverIn);
+	CostMap costs = readRepairCost(repairUserIn);
+	YearFactors factors = yearFactorsCompiler(bridge, bridge.nYears);
+	ImproveMat impMat = improveCoefficients();
+
+	vector<string> parts = componentParts(serverIn.componentType);
+	vector<ConditionFrontier> frontiers(parts.size());
+	for (int p = 0; p < parts.size(); p++) {
+		RepairEnvMat repairs = envInfoCompiler(repairUserIn, parts[p], data->basicInfo(), data->envCoef(costObject), data->catalog(costObject));
+		frontiers[p] = findCostFrontier(bridge, ratingsDecay, repairs, costs, impMat, factors, limit);
+	}
+	return frontiers;
+}
+
+/*
+ * Implementation: solveUncertainty
+ * -------------------------------------------------------
+ * The cost tables do not depend on the deterioration curve, so they are built once and every
+ * sample only runs the DP. The samples are spread over one task per thread of the solver pool.
+ */
+UncertaintyResult 
+BlackBoxI::
+solveUncertainty(const UserInput& userIn, const SamplingOptions& sampling, const RepairInfoMat& repairUserIn)
+{
+	const int maxSamples = 100000;
+	if (sampling.samples < 1 || sampling.samples > maxSamples)
+		throw BlackBoxError("The number of samples must be between 1 and 100000");
+
+	ServerInput serverIn;
+	ComponentRatingMat ServerRatings;
+	fetchServerInputs(userIn, serverIn, ServerRatings);
+	ReferenceDataPtr data = _referenceData->current();
+
+	int optObj = userIn.optObject;
+	int limit = userIn.ratingLowerLimit;
+	BridgeInfo bridge = bridgeInfoCompiler(userIn, serverIn);
+	CostMap costs = readRepairCost(repairUserIn);
+	YearFactors factors = yearFactorsCompiler(bridge, bridge.nYears);
+	ImproveMat impMat = improveCoefficients();
+
+	// the curve fitted to the ratings, whose schedule the samples are compared with
+	DecaySampler sampler(ServerRatings);
+	int ratingsDecay[10][10];
+	::ratingDecay(ratingsDecay, sampler.coefficients(), limit);
+
+	bool costObjective = (optObj == 11);
+	vector<string> parts = componentParts(serverIn.componentType);
+	vector<RepairCostTable> tables = costTables(bridge, repairUserIn, parts, data, optObj, costs, impMat, factors, limit);
+
+	RepairSchedule optSchedule;
+	float minCost = sampleOptimum(bridge, ratingsDecay, tables, limit, costObjective, optSchedule);
+
+	// the samples are timed on the monotonic clock of the stage times, not in CPU time
+	IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+	SampleRun run(bridge, sampler, tables, limit, costObjective, sampling.seed, sampling.samples);
+	int nChunks = (sampling.samples + SampleRun::samplesPerChunk - 1)/SampleRun::samplesPerChunk;
+	vector<SampleTaskPtr> tasks;
+	for (int i = 0; i < min(_solverPool->size(), nChunks); i++)
+		tasks.push_back(new SampleTask(run));
+	solveParts(_solverPool, tasks);
+
+	vector<float> minima;
+	vector<RepairSchedule> schedules;
+	for (int s = 0; s < sampling.samples; s++) {
+		if (!run.solved[s])
+			continue;
+		minima.push_back(run.minimum[s]);
+		schedules.push_back(RepairSchedule());
+		schedules.back().swap(run.schedule[s]);
+	}
+	LOG_DEBUG("Samples solved: " << minima.size() << " of " << sampling.samples << " in " << (IceUtil::Time::now(IceUtil::Time::Monotonic) - start).toSecondsDouble());
+
+	UncertaintyResult result;
+	result.fitted = scheduleResult(minCost, optSchedule);
+
+	SampleSummary summary = summarizeSamples(minima);
+	result.minimum.solved = summary.samples;
+	result.minimum.rejected = sampling.samples - summary.samples;
+	result.minimum.mean = summary.mean;
+	result.minimum.stdDev = summary.stdDev;
+	result.minimum.minimum = summary.minimum;
+	result.minimum.p5 = summary.p5;
+	result.minimum.median = summary.median;
+	result.minimum.p95 = summary.p95;
+	result.minimum.maximum = summary.maximum;
+
+	vector<TimingSpread> spread = timingSpread(optSchedule, schedules);
+	for (int r = 0; r < spread.size(); r++) {
+		RepairTiming timing;
+		timing.repairID = spread[r].repairID;
+		timing.year = spread[r].year;
+		timing.frequency = spread[r].frequency;
+		timing.meanYear = spread[r].meanYear;
+		timing.stdDevYear = spread[r].stdDevYear;
+		timing.earliest = spread[r].earliest;
+		timing.latest = spread[r].latest;
+		result.timing.push_back(timing);
+	}
+	return result;
+}
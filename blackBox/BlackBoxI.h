@@ -0,0 +1,144 @@
+//
+//  BlackBoxI.h
+//  blackBox
+//
+//  Servant of the Ice interface LCO::BlackBox.
+//
+
+#ifndef blackBox_BlackBoxI_h
+#define blackBox_BlackBoxI_h
+
+#include "LCO.h"
+#include "ThreadPool.h"
+#include "SenStorePool.h"
+#include "ReferenceData.h"
+#include "DecayCache.h"
+#include "ResultCache.h"
+#include "LatencyStats.h"
+#include "FindOptSchedule.h"
+#include <Ice/Ice.h>
+
+using namespace LCO;
+
+/*
+ * Class: BlackBoxI
+ * -----------------------------------------------------------------------------
+ * BlackBoxI is the incarnation of the interface BlackBox.
+ * optSchedule is dispatched asynchronously: each request is queued as a job on the
+ * request pool and the Ice thread returns at once. When the queue of the request pool
+ * is full the request is refused with BlackBoxBusy; a batch takes one place in the queue.
+ * The sub-schedules of a span, and the bridges of a fleet, are solved on the solver pool. SenStore is reached through
+ * the proxies of the shared SenStorePool, and the Data files are read from the current
+ * ReferenceData snapshot. The ratings and the deterioration curves fitted to them are
+ * kept in the DecayCache between requests, and the results of optSchedule in the ResultCache.
+ * The stages of optSchedule are timed into the LatencyStats.
+ */
+class BlackBoxI : public BlackBox {
+public:
+	BlackBoxI(const ThreadPoolPtr& requestPool, const ThreadPoolPtr& solverPool, const SenStorePoolPtr& senStore, const ReferenceDataStorePtr& referenceData,
+		const DecayCachePtr& decayCache, const ResultCachePtr& resultCache, const LatencyStatsPtr& latency);
+	virtual void optSchedule_async(const AMD_BlackBox_optSchedulePtr& cb, const UserInput& userIn, const ComponentRatingMat& ratings, const RepairInfoMat& repairInfo, const ::Ice::Current&);
+	virtual void optScheduleBatch(const ScheduleJobSeq& jobs, const ScheduleObserverPrx& observer, const ::Ice::Current&);
+	virtual void optScheduleWeighted_async(const AMD_BlackBox_optScheduleWeightedPtr& cb, const UserInput& userIn, const ObjectiveValues& weights, const ComponentRatingMat& ratings, const RepairInfoMat& repairInfo, const ::Ice::Current&);
+	virtual void optScheduleFront_async(const AMD_BlackBox_optScheduleFrontPtr& cb, const UserInput& userIn, const ObjectiveSeq& objectives, const ComponentRatingMat& ratings, const RepairInfoMat& repairInfo, const ::Ice::Current&);
+	virtual void optScheduleUncertainty_async(const AMD_BlackBox_optScheduleUncertaintyPtr& cb, const UserInput& userIn, const SamplingOptions& sampling, const ComponentRatingMat& ratings, const RepairInfoMat& repairInfo, const ::Ice::Current&);
+	virtual void optScheduleMarkov_async(const AMD_BlackBox_optScheduleMarkovPtr& cb, const UserInput& userIn, const ComponentRatingMat& ratings, const RepairInfoMat& repairInfo, const ::Ice::Current&);
+	virtual void optFleetBudget_async(const AMD_BlackBox_optFleetBudgetPtr& cb, const ScheduleJobSeq& jobs, const FleetBudget& budget, const ::Ice::Current&);
+
+	/*
+	 * Function: solveSchedule
+	 * Usage: result = solveSchedule(userIn, repairUserIn);
+	 * -----------------------------------------------------------------------------
+	 * Finds the optimal schedule of one component, writes the optimum and the schedule to
+	 * SenStore and returns them.
+	 * Runs on a thread of the request pool; errors are thrown as BlackBoxError.
+	 * The first form returns the result of an equal request from the result cache, if it
+	 * is kept there, without writing it again. The second form takes the SenStore inputs
+	 * and the reference data already fetched, and always solves.
+	 */
+	ScheduleResult solveSchedule(const UserInput& userIn, const RepairInfoMat& repairUserIn);
+	ScheduleResult solveSchedule(const UserInput& userIn, const RepairInfoMat& repairUserIn, const ServerInput& serverIn, const ComponentRatingMat& serverRatings,
+		const ReferenceDataPtr& data, const SenStoreMngrPrx& manager);
+
+	/*
+	 * Function: solveFront
+	 * Usage: front = solveFront(userIn, objectives, repairUserIn);
+	 * -----------------------------------------------------------------------------
+	 * Finds the Pareto front of the schedules of one component for the objectives, each
+	 * a value of optObject, and returns it without writing to SenStore.
+	 */
+	FrontScheduleSeq solveFront(const UserInput& userIn, const ObjectiveSeq& objectives, const RepairInfoMat& repairUserIn);
+
+	/*
+	 * Function: solveWeighted
+	 * Usage: result = solveWeighted(userIn, weights, repairUserIn);
+	 * -----------------------------------------------------------------------------
+	 * Finds the schedule of one component minimizing the weighted sum of the objectives 1-11,
+	 * weights[o] being the weight of objective o+1, and returns it without writing to SenStore.
+	 */
+	ScheduleResult solveWeighted(const UserInput& userIn, const ObjectiveValues& weights, const RepairInfoMat& repairUserIn);
+
+	/*
+	 * Function: solveUncertainty
+	 * Usage: result = solveUncertainty(userIn, sampling, repairUserIn);
+	 * -----------------------------------------------------------------------------
+	 * Solves the component for the curve fitted to its ratings and for sampling.samples curves
+	 * sampled around it, in parallel on the solver pool, and returns the spread of the optimum
+	 * and of the repairs' years. Nothing is written to SenStore.
+	 */
+	UncertaintyResult solveUncertainty(const UserInput& userIn, const SamplingOptions& sampling, const RepairInfoMat& repairUserIn);
+
+	/*
+	 * Function: solveMarkov
+	 * Usage: result = solveMarkov(userIn, repairUserIn);
+	 * -----------------------------------------------------------------------------
+	 * Estimates the Markov model of the component from its ratings in SenStore and finds the
+	 * policy of each of its parts by value iteration. Nothing is written to SenStore.
+	 */
+	MarkovResult solveMarkov(const UserInput& userIn, const RepairInfoMat& repairUserIn);
+
+	/*
+	 * Function: solveFleet
+	 * Usage: plan = solveFleet(jobs, budget);
+	 * -----------------------------------------------------------------------------
+	 * Finds the cost frontier of every job's component, the bridges in parallel on the solver
+	 * pool, then chooses one schedule per component within the yearly budgets with allocateBudget.
+	 * A job that fails is reported in its choice and left out of the allocation.
+	 */
+	FleetPlan solveFleet(const ScheduleJobSeq& jobs, const FleetBudget& budget);
+
+	/*
+	 * Function: costFrontiers
+	 * Usage: frontiers = costFrontiers(userIn, repairUserIn, serverIn, serverRatings, data);
+	 * -----------------------------------------------------------------------------
+	 * The cost frontier of each part of one component, from inputs already fetched: one
+	 * frontier for most components, four for a span. Nothing is written to SenStore.
+	 */
+	vector<ConditionFrontier> costFrontiers(const UserInput& userIn, const RepairInfoMat& repairUserIn, const ServerInput& serverIn, const ComponentRatingMat& serverRatings,
+		const ReferenceDataPtr& data);
+
+	/*
+	 * Function: fetchRatings
+	 * Usage: ratings = fetchRatings(manager, bridgeID);
+	 * -----------------------------------------------------------------------------
+	 * The condition ratings of the bridge, from the decay cache while they are kept there,
+	 * read from SenStore with "manager" otherwise.
+	 */
+	ComponentRatingMat fetchRatings(const SenStoreMngrPrx& manager, int bridgeID);
+
+private:
+	SenStoreMngrPrx fetchServerInputs(const UserInput& userIn, ServerInput& serverIn, ComponentRatingMat& ServerRatings);
+	void ratingDecay(int ratingsDecay[][10], const UserInput& userIn, const ComponentRatingMat& ServerRatings);
+
+	ThreadPoolPtr _requestPool;
+	ThreadPoolPtr _solverPool;
+	SenStorePoolPtr _senStore;
+	ReferenceDataStorePtr _referenceData;
+	DecayCachePtr _decayCache;
+	ResultCachePtr _resultCache;
+	LatencyStatsPtr _latency;
+};
+
+typedef IceUtil::Handle<BlackBoxI> BlackBoxIPtr;
+
+#endif
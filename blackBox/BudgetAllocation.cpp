@@ -0,0 +1,312 @@
+#include "BudgetAllocation.h"
+#include <math.h>
+#include <algorithm>
+#include <limits>
+
+// relaxed choices overspending the budgets by more than this, relative to them, are not repaired
+static const double repairThreshold = 0.1;
+
+/*
+ * Implementation: fleetComponent
+ * ------------------------------
+ * Options are kept in the order of the first part's frontier, the final ratings every part reaches.
+ */
+FleetComponent fleetComponent(const vector<ConditionFrontier> &parts, int budgetStartYear, int nBudgetYears) {
+	FleetComponent component;
+	if (parts.empty())
+		return component;
+
+	for (int c = 0; c < parts[0].size(); c++) {
+		FleetOption option;
+		option.finalRating = parts[0][c].finalRating;
+		option.total = 0.0f;
+		option.spend.assign(nBudgetYears, 0.0f);
+
+		bool reached = true;
+		for (int p = 0; p < parts.size() && reached; p++) {
+			const ConditionSchedule *condition = 0;
+			for (int k = 0; k < parts[p].size(); k++) {
+				if (parts[p][k].finalRating == option.finalRating)
+					condition = &parts[p][k];
+			}
+			if (condition == 0) {
+				reached = false;
+				break;
+			}
+
+			option.total += condition->minimum;
+			for (int r = 0; r < condition->schedule.size(); r++) {
+				int year = condition->schedule[r].repairYear - budgetStartYear;
+				if (year >= 0 && year < nBudgetYears)
+					option.spend[year] += condition->schedule[r].value;
+			}
+		}
+		if (reached)
+			component.options.push_back(option);
+	}
+	return component;
+}
+
+/*
+ * Implementation: scales
+ * ------------------------------
+ * Budgets the spending of each year is measured against; a year without budget counts in units of 1.
+ */
+static vector<double> scales(const vector<float> &budgets) {
+	vector<double> scale(budgets.size());
+	for (int y = 0; y < budgets.size(); y++)
+		scale[y] = budgets[y] > 0 ? budgets[y] : 1.0;
+	return scale;
+}
+
+/*
+ * Implementation: evaluate
+ * ------------------------------
+ * Fills spent and benefit of "allocation" from its choice.
+ */
+static void evaluate(const vector<FleetComponent> &components, int nYears, FleetAllocation &allocation) {
+	allocation.spent.assign(nYears, 0.0f);
+	allocation.benefit = 0;
+	for (int c = 0; c < components.size(); c++) {
+		if (allocation.choice[c] < 0)
+			continue;
+		const FleetOption &option = components[c].options[allocation.choice[c]];
+		allocation.benefit += option.finalRating;
+		for (int y = 0; y < nYears; y++)
+			allocation.spent[y] += option.spend[y];
+	}
+}
+
+/*
+ * Implementation: overspending
+ * ------------------------------
+ * Sum over the years of the spending beyond the budget, relative to it.
+ */
+static double overspending(const vector<float> &spent, const vector<float> &budgets, const vector<double> &scale) {
+	double excess = 0.0;
+	for (int y = 0; y < budgets.size(); y++) {
+		if (spent[y] > budgets[y])
+			excess += (spent[y] - budgets[y])/scale[y];
+	}
+	return excess;
+}
+
+static void switchOption(const vector<FleetComponent> &components, FleetAllocation &allocation, int c, int o) {
+	const FleetOption &current = components[c].options[allocation.choice[c]];
+	const FleetOption &option = components[c].options[o];
+	for (int y = 0; y < allocation.spent.size(); y++)
+		allocation.spent[y] += option.spend[y] - current.spend[y];
+	allocation.benefit += option.finalRating - current.finalRating;
+	allocation.choice[c] = o;
+}
+
+/*
+ * Implementation: repairAllocation
+ * ------------------------------
+ * Brings the spending within the budgets one switch at a time: the switch giving up the least
+ * condition per unit of overspending removed, summed over the years relative to their budgets.
+ * Every switch removes some, so this ends; returns false if the budgets cannot be met that way.
+ */
+static bool repairAllocation(const vector<FleetComponent> &components, const vector<float> &budgets, const vector<double> &scale, FleetAllocation &allocation) {
+	int nYears = budgets.size();
+	while (true) {
+		double excess = overspending(allocation.spent, budgets, scale);
+		if (excess <= 0)
+			return true;
+
+		int bestComponent = -1, bestOption = -1;
+		double bestRatio = numeric_limits<double>::infinity(), bestReduction = 0.0;
+		for (int c = 0; c < components.size(); c++) {
+			if (allocation.choice[c] < 0)
+				continue;
+			const FleetOption &current = components[c].options[allocation.choice[c]];
+
+			for (int o = 0; o < components[c].options.size(); o++) {
+				const FleetOption &option = components[c].options[o];
+				double after = 0.0;
+				for (int y = 0; y < nYears; y++) {
+					double spent = (double)allocation.spent[y] - current.spend[y] + option.spend[y];
+					if (spent > budgets[y])
+						after += (spent - budgets[y])/scale[y];
+				}
+				double reduction = excess - after;
+				if (reduction <= 1e-12)
+					continue;
+
+				double ratio = (current.finalRating - option.finalRating)/reduction;
+				if (ratio < bestRatio || (ratio == bestRatio && reduction > bestReduction)) {
+					bestComponent = c;
+					bestOption = o;
+					bestRatio = ratio;
+					bestReduction = reduction;
+				}
+			}
+		}
+		if (bestComponent < 0)
+			return false;
+		switchOption(components, allocation, bestComponent, bestOption);
+	}
+}
+
+struct Upgrade {
+	int component;
+	int option;
+	double ratio;
+};
+
+static bool betterUpgrade(const Upgrade &a, const Upgrade &b) {
+	return a.ratio > b.ratio;
+}
+
+/*
+ * Implementation: fillAllocation
+ * ------------------------------
+ * Spends what the budget has left on upgrades, the most condition per unit of cost first,
+ * as long as every year stays within its budget.
+ */
+static void fillAllocation(const vector<FleetComponent> &components, const vector<float> &budgets, FleetAllocation &allocation) {
+	int nYears = budgets.size();
+	vector<Upgrade> upgrades;
+	for (int c = 0; c < components.size(); c++) {
+		if (allocation.choice[c] < 0)
+			continue;
+		const FleetOption &current = components[c].options[allocation.choice[c]];
+		for (int o = 0; o < components[c].options.size(); o++) {
+			const FleetOption &option = components[c].options[o];
+			if (option.finalRating <= current.finalRating)
+				continue;
+			Upgrade upgrade;
+			upgrade.component = c;
+			upgrade.option = o;
+			upgrade.ratio = (option.finalRating - current.finalRating)/max((double)(option.total - current.total), 1e-9);
+			upgrades.push_back(upgrade);
+		}
+	}
+	stable_sort(upgrades.begin(), upgrades.end(), betterUpgrade);
+
+	for (int u = 0; u < upgrades.size(); u++) {
+		int c = upgrades[u].component;
+		const FleetOption &current = components[c].options[allocation.choice[c]];
+		const FleetOption &option = components[c].options[upgrades[u].option];
+		if (option.finalRating <= current.finalRating)
+			continue;
+
+		bool fits = true;
+		for (int y = 0; y < nYears && fits; y++) {
+			if (allocation.spent[y] - current.spend[y] + option.spend[y] > budgets[y])
+				fits = false;
+		}
+		if (fits)
+			switchOption(components, allocation, c, upgrades[u].option);
+	}
+}
+
+/*
+ * Implementation: allocateBudget
+ * ------------------------------
+ * With multipliers lambda[year] on the spending relative to the budget, the relaxed problem is
+ * solved by each component choosing the option with the largest finalRating - sum(lambda*spend).
+ * Its value is an upper bound of the benefit, so the search stops once a choice within the budget
+ * reaches it. The steps are Polyak's, towards the best benefit found so far.
+ */
+FleetAllocation allocateBudget(const vector<FleetComponent> &components, const vector<float> &budgets, int maxIterations) {
+	int nComponents = components.size();
+	int nYears = budgets.size();
+	vector<double> scale = scales(budgets);
+
+	// start from the cheapest option of every component, the choice least likely to overspend
+	FleetAllocation best;
+	best.choice.assign(nComponents, -1);
+	for (int c = 0; c < nComponents; c++) {
+		double cheapest = numeric_limits<double>::infinity();
+		for (int o = 0; o < components[c].options.size(); o++) {
+			double cost = 0.0;
+			for (int y = 0; y < nYears; y++)
+				cost += components[c].options[o].spend[y]/scale[y];
+			if (cost < cheapest) {
+				cheapest = cost;
+				best.choice[c] = o;
+			}
+		}
+	}
+	evaluate(components, nYears, best);
+	best.withinBudget = repairAllocation(components, budgets, scale, best);
+	best.iterations = 0;
+
+	vector<double> lambda(nYears, 0.0);
+	double theta = 2.0;
+	double bestBound = numeric_limits<double>::infinity();
+	int stalled = 0;
+	FleetAllocation relaxed;
+	relaxed.choice.assign(nComponents, -1);
+	for (int iteration = 1; iteration <= maxIterations; iteration++) {
+		best.iterations = iteration;
+
+		// the relaxed problem, component by component
+		double bound = 0.0;
+		for (int y = 0; y < nYears; y++)
+			bound += lambda[y]*budgets[y]/scale[y];
+		for (int c = 0; c < nComponents; c++) {
+			double bestValue = -numeric_limits<double>::infinity();
+			for (int o = 0; o < components[c].options.size(); o++) {
+				const FleetOption &option = components[c].options[o];
+				double value = option.finalRating;
+				for (int y = 0; y < nYears; y++)
+					value -= lambda[y]*option.spend[y]/scale[y];
+				if (value > bestValue || (value == bestValue && option.total < components[c].options[relaxed.choice[c]].total)) {
+					bestValue = value;
+					relaxed.choice[c] = o;
+				}
+			}
+			if (relaxed.choice[c] >= 0)
+				bound += bestValue;
+		}
+		evaluate(components, nYears, relaxed);
+
+		double excess = overspending(relaxed.spent, budgets, scale);
+		if (excess <= repairThreshold) {
+			FleetAllocation candidate = relaxed;
+			if (repairAllocation(components, budgets, scale, candidate)) {
+				fillAllocation(components, budgets, candidate);
+				if (!best.withinBudget || candidate.benefit > best.benefit) {
+					candidate.withinBudget = true;
+					candidate.iterations = iteration;
+					best = candidate;
+				}
+			}
+		}
+
+		// the benefits are whole conditions, so no choice beats a bound less than one above the best
+		if (best.withinBudget && floor(bound + 1e-6) <= best.benefit)
+			break;
+
+		if (bound < bestBound - 1e-9) {
+			bestBound = bound;
+			stalled = 0;
+		} else if (++stalled >= 5) {
+			theta /= 2;
+			stalled = 0;
+		}
+
+		double norm = 0.0;
+		vector<double> gradient(nYears);
+		for (int y = 0; y < nYears; y++) {
+			gradient[y] = (relaxed.spent[y] - budgets[y])/scale[y];
+			// a multiplier at 0 is not lowered further
+			if (lambda[y] <= 0 && gradient[y] < 0)
+				gradient[y] = 0;
+			norm += gradient[y]*gradient[y];
+		}
+		if (norm == 0)
+			break;
+
+		double target = best.withinBudget ? best.benefit : 0.0;
+		double step = theta*max(bound - target, 1e-6)/norm;
+		for (int y = 0; y < nYears; y++)
+			lambda[y] = max(0.0, lambda[y] + step*gradient[y]);
+	}
+
+	if (best.withinBudget)
+		fillAllocation(components, budgets, best);
+	return best;
+}
@@ -0,0 +1,78 @@
+//
+//  BudgetAllocation.h
+//  blackBox
+//
+//  Spreads a yearly repair budget over the components of a fleet of bridges, choosing
+//  for each one of the schedules of its cost frontier.
+//
+
+#ifndef blackBox_BudgetAllocation_h
+#define blackBox_BudgetAllocation_h
+
+#include "FindOptSchedule.h"
+#include <vector>
+
+using namespace std;
+
+/*
+ * Struct: FleetOption
+ * -----------------------------------------------------------------------------
+ * A schedule a component may follow: the condition it ends the plan in, its total cost
+ * and what it spends in each year of the budget, spend[year - budget start year].
+ */
+struct FleetOption {
+	int finalRating;
+	float total;
+	vector<float> spend;
+};
+
+/*
+ * Struct: FleetComponent
+ * -----------------------------------------------------------------------------
+ * The options of one component, by increasing final condition. A component without
+ * options cannot be planned and is left out of the allocation.
+ */
+struct FleetComponent {
+	vector<FleetOption> options;
+};
+
+/*
+ * Struct: FleetAllocation
+ * -----------------------------------------------------------------------------
+ * choice[component] is the index of the option chosen for it, -1 if it has none.
+ * spent[year] is the total of the chosen options in each year of the budget, and
+ * benefit the sum of their final conditions. withinBudget is false if no choice within the
+ * budgets was found, as when even the cheapest options overspend some year; the allocation is
+ * then the cheapest one, brought as close to the budgets as the repair could.
+ */
+struct FleetAllocation {
+	vector<int> choice;
+	vector<float> spent;
+	int benefit;
+	bool withinBudget;
+	int iterations;
+};
+
+/*
+ * Function: fleetComponent
+ * Usage: component = fleetComponent(parts, budgetStartYear, nBudgetYears);
+ * -----------------------------------------------------------------------------
+ * The options of a component from the cost frontiers of its parts, one for most components
+ * and four for a span. An option ends every part in the same condition; the parts' schedules
+ * are added up year by year, the repairs outside the budget years being left out of spend.
+ */
+FleetComponent fleetComponent(const vector<ConditionFrontier> &parts, int budgetStartYear, int nBudgetYears);
+
+/*
+ * Function: allocateBudget
+ * Usage: allocation = allocateBudget(components, budgets, maxIterations);
+ * -----------------------------------------------------------------------------
+ * Chooses one option per component so that the sum of the final conditions is the largest
+ * the yearly budgets allow. The budget constraints are relaxed with a Lagrange multiplier per
+ * year, so that every component is chosen on its own, and the multipliers are found by subgradient
+ * steps; each relaxed choice close to the budget is then repaired into one that fits it.
+ * Stops after maxIterations steps or when the relaxed choice is proven optimal.
+ */
+FleetAllocation allocateBudget(const vector<FleetComponent> &components, const vector<float> &budgets, int maxIterations = 200);
+
+#endif
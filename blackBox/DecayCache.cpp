@@ -0,0 +1,190 @@
+#include "DecayCache.h"
+#include "Logger.h"
+
+/*
+ * Implementation: historyHash
+ * ------------------------------
+ * FNV-1a over the years and the ratings, in their order.
+ */
+static unsigned int historyHash(const ComponentRatingMat &ratings) {
+	unsigned int hash = 2166136261u;
+	const vector<int> *fields[2] = { &ratings.years, &ratings.ratings };
+	for (int f = 0; f < 2; f++) {
+		hash = (hash ^ (unsigned int)fields[f]->size()) * 16777619u;
+		for (int i = 0; i < fields[f]->size(); i++) {
+			unsigned int value = (unsigned int)(*fields[f])[i];
+			for (int b = 0; b < 4; b++) {
+				hash = (hash ^ (value & 0xff)) * 16777619u;
+				value >>= 8;
+			}
+		}
+	}
+	return hash;
+}
+
+static bool sameHistory(const ComponentRatingMat &a, const ComponentRatingMat &b) {
+	return a.years == b.years && a.ratings == b.ratings;
+}
+
+bool DecayCache::DecayKey::operator<(const DecayKey &other) const {
+	if (bridgeID != other.bridgeID)
+		return bridgeID < other.bridgeID;
+	if (componentID != other.componentID)
+		return componentID < other.componentID;
+	if (limit != other.limit)
+		return limit < other.limit;
+	return hash < other.hash;
+}
+
+/*
+ * Implementation: DecayCache
+ * ------------------------------
+ *
+ */
+DecayCache::DecayCache(int ttl) :
+	_ttl(IceUtil::Time::seconds(ttl > 0 ? ttl : 0)), _lastSweep(IceUtil::Time::now(IceUtil::Time::Monotonic)), _generation(0), _hits(0), _misses(0)
+{
+}
+
+bool DecayCache::expired(const IceUtil::Time &stored, const IceUtil::Time &now) const {
+	return now - stored >= _ttl;
+}
+
+/*
+ * Implementation: removeExpired
+ * ------------------------------
+ * Called with the lock held. Entries of histories that are no longer read would otherwise stay,
+ * so the maps are swept once per ttl.
+ */
+void DecayCache::removeExpired(const IceUtil::Time &now) {
+	if (now - _lastSweep < _ttl)
+		return;
+	_lastSweep = now;
+
+	for (map<pair<int, int>, RatingsEntry>::iterator it = _ratings.begin(); it != _ratings.end(); ) {
+		if (expired(it->second.stored, now))
+			_ratings.erase(it++);
+		else
+			++it;
+	}
+	for (map<DecayKey, DecayEntry>::iterator it = _decay.begin(); it != _decay.end(); ) {
+		if (expired(it->second.stored, now))
+			_decay.erase(it++);
+		else
+			++it;
+	}
+}
+
+/*
+ * Implementation: ratings
+ * ------------------------------
+ * SenStore is read without the lock; two requests missing at once both read, and the later one is kept.
+ * Ratings read across an invalidation may predate the update, so they are returned but not kept.
+ */
+ComponentRatingMat DecayCache::ratings(const SenStoreMngrPrx &manager, int bridgeID, int componentID) {
+	pair<int, int> key(bridgeID, componentID);
+	int generation = 0;
+	if (_ttl > IceUtil::Time()) {
+		IceUtil::Mutex::Lock lock(_mutex);
+		map<pair<int, int>, RatingsEntry>::const_iterator it = _ratings.find(key);
+		if (it != _ratings.end() && !expired(it->second.stored, IceUtil::Time::now(IceUtil::Time::Monotonic)))
+			return it->second.ratings;
+		generation = _generation;
+	}
+
+	ComponentRatingMat ratings = readRatings(manager, bridgeID, componentID);
+	if (_ttl > IceUtil::Time() && !ratings.ratings.empty()) {
+		IceUtil::Mutex::Lock lock(_mutex);
+		if (_generation != generation)
+			return ratings;
+		IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+		removeExpired(now);
+		RatingsEntry &entry = _ratings[key];
+		entry.ratings = ratings;
+		entry.stored = now;
+	}
+	return ratings;
+}
+
+/*
+ * Implementation: ratingDecay
+ * ------------------------------
+ * The ratings of an entry are compared as well as their hash, so a collision only costs a fit.
+ * As in ratings, a matrix fitted across an invalidation is not kept.
+ */
+void DecayCache::ratingDecay(int ratingsDecay[][10], int bridgeID, int componentID, const ComponentRatingMat &ratings, int limit) {
+	DecayKey key;
+	key.bridgeID = bridgeID;
+	key.componentID = componentID;
+	key.limit = limit;
+	key.hash = historyHash(ratings);
+
+	int generation = 0;
+	if (_ttl > IceUtil::Time()) {
+		IceUtil::Mutex::Lock lock(_mutex);
+		map<DecayKey, DecayEntry>::const_iterator it = _decay.find(key);
+		if (it != _decay.end() && sameHistory(it->second.ratings, ratings) && !expired(it->second.stored, IceUtil::Time::now(IceUtil::Time::Monotonic))) {
+			for (int i = 0; i < 10; i++)
+				for (int j = 0; j < 10; j++)
+					ratingsDecay[i][j] = it->second.ratingsDecay[i][j];
+			_hits++;
+			return;
+		}
+		_misses++;
+		generation = _generation;
+	}
+
+	::ratingDecay(ratingsDecay, ratings, limit);
+	if (_ttl > IceUtil::Time()) {
+		IceUtil::Mutex::Lock lock(_mutex);
+		if (_generation != generation)
+			return;
+		IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+		removeExpired(now);
+		DecayEntry &entry = _decay[key];
+		entry.ratings = ratings;
+		for (int i = 0; i < 10; i++)
+			for (int j = 0; j < 10; j++)
+				entry.ratingsDecay[i][j] = ratingsDecay[i][j];
+		entry.stored = now;
+	}
+}
+
+void DecayCache::invalidate() {
+	IceUtil::Mutex::Lock lock(_mutex);
+	_ratings.clear();
+	_decay.clear();
+	_generation++;
+}
+
+int DecayCache::generation() {
+	IceUtil::Mutex::Lock lock(_mutex);
+	return _generation;
+}
+
+CacheStats DecayCache::stats() {
+	IceUtil::Mutex::Lock lock(_mutex);
+	CacheStats stats;
+	stats.hits = _hits;
+	stats.misses = _misses;
+	stats.entries = _decay.size();
+	stats.capacity = 0;
+	return stats;
+}
+
+/*
+ * Implementation: DecayCacheEventsI
+ * ------------------------------
+ *
+ */
+DecayCacheEventsI::DecayCacheEventsI(const DecayCachePtr &cache, const vector<string> &classes) :
+	_cache(cache), _classes(classes.begin(), classes.end())
+{
+}
+
+void DecayCacheEventsI::reportSignalDataUpdated(const SenStore::SignalDataUpdatedEvent &event, const Ice::Current&) {
+	if (!_classes.empty() && _classes.find(event.className) == _classes.end())
+		return;
+	_cache->invalidate();
+	LOG_INFO("Decay cache invalidated by an update of " << event.className << " " << event.id);
+}
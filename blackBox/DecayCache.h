@@ -0,0 +1,133 @@
+//
+//  DecayCache.h
+//  blackBox
+//
+//  Condition ratings read from SenStore and the deterioration curves fitted to them, kept
+//  between requests until they expire or SenStore reports that its data changed.
+//
+
+#ifndef blackBox_DecayCache_h
+#define blackBox_DecayCache_h
+
+#include "Input.h"
+#include "SenStore.h"
+#include <Ice/Ice.h>
+#include <IceUtil/IceUtil.h>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/*
+ * Class: DecayCache
+ * -----------------------------------------------------------------------------
+ * Remembers the ratings of a bridge and the ratingsDecay matrices computed from them, so that
+ * repeated requests on the same bridge neither read the ratings again nor fit the curve again.
+ * A matrix is kept under (bridgeID, componentID, limit) and a hash of the ratings and years it
+ * was fitted to, so a changed history never finds an old one. Entries expire "ttl" seconds
+ * after they were stored, and invalidate() drops them all at once; a ttl of 0 turns the cache
+ * off. The cache is shared by all requests and locks on every call.
+ */
+class DecayCache : public IceUtil::Shared {
+public:
+	DecayCache(int ttl);
+
+	/*
+	 * Function: ratings
+	 * Usage: ratings = cache->ratings(manager, bridgeID, componentID);
+	 * -----------------------------------------------------------------------------
+	 * The ratings readRatings returns, read with "manager" only if none are kept. The errors
+	 * of readRatings are thrown, and an empty history is not kept.
+	 */
+	ComponentRatingMat ratings(const SenStoreMngrPrx &manager, int bridgeID, int componentID);
+
+	/*
+	 * Function: ratingDecay
+	 * Usage: cache->ratingDecay(ratingsDecay, bridgeID, componentID, ratings, limit);
+	 * -----------------------------------------------------------------------------
+	 * Fills ratingsDecay as ratingDecay(ratingsDecay, ratings, limit) does, fitting the curve only
+	 * if no matrix is kept for these ratings. The errors of the fit are thrown and not kept.
+	 */
+	void ratingDecay(int ratingsDecay[][10], int bridgeID, int componentID, const ComponentRatingMat &ratings, int limit);
+
+	/*
+	 * Function: invalidate
+	 * Usage: cache->invalidate();
+	 * -----------------------------------------------------------------------------
+	 * Drop every entry; the next requests read and fit again.
+	 */
+	void invalidate();
+
+	/*
+	 * Function: generation
+	 * Usage: generation = cache->generation();
+	 * -----------------------------------------------------------------------------
+	 * Number of the invalidations so far, for the results computed from the ratings to be
+	 * told apart from those of ratings read after an invalidation.
+	 */
+	int generation();
+
+	/*
+	 * Function: stats
+	 * Usage: CacheStats stats = cache->stats();
+	 * -----------------------------------------------------------------------------
+	 * The fits answered from the cache and those computed, since the server started, and
+	 * the matrices kept. The cache is not bounded, so the capacity is 0.
+	 */
+	CacheStats stats();
+
+private:
+	struct DecayKey {
+		int bridgeID;
+		int componentID;
+		int limit;
+		unsigned int hash;
+		bool operator<(const DecayKey &other) const;
+	};
+
+	struct DecayEntry {
+		ComponentRatingMat ratings;
+		int ratingsDecay[10][10];
+		IceUtil::Time stored;
+	};
+
+	struct RatingsEntry {
+		ComponentRatingMat ratings;
+		IceUtil::Time stored;
+	};
+
+	bool expired(const IceUtil::Time &stored, const IceUtil::Time &now) const;
+	void removeExpired(const IceUtil::Time &now);
+
+	IceUtil::Mutex _mutex;
+	IceUtil::Time _ttl;
+	map<pair<int, int>, RatingsEntry> _ratings;
+	map<DecayKey, DecayEntry> _decay;
+	IceUtil::Time _lastSweep;
+	int _generation;
+	Ice::Long _hits;
+	Ice::Long _misses;
+};
+
+typedef IceUtil::Handle<DecayCache> DecayCachePtr;
+
+/*
+ * Class: DecayCacheEventsI
+ * -----------------------------------------------------------------------------
+ * Subscriber of the SenStore events published through IceStorm. An event about a class of
+ * "classes" invalidates the cache, since the event does not tell which bridge the object
+ * belongs to; other events are ignored. An empty "classes" takes every event.
+ */
+class DecayCacheEventsI : public SenStore::EventHandler {
+public:
+	DecayCacheEventsI(const DecayCachePtr &cache, const vector<string> &classes);
+	virtual void reportSignalDataUpdated(const SenStore::SignalDataUpdatedEvent &event, const Ice::Current&);
+
+private:
+	DecayCachePtr _cache;
+	set<string> _classes;
+};
+
+#endif
@@ -0,0 +1,176 @@
+#include "DecaySampling.h"
+#include "PolyFit.h"
+#include <math.h>
+#include <algorithm>
+#include <map>
+
+/*
+ * Implementation: SampleStream
+ * ------------------------------
+ * The state is seeded by splitmix64 from the seed and the stream, so that neighbouring
+ * streams do not start from similar states.
+ */
+SampleStream::SampleStream(unsigned int seed, unsigned int stream)
+{
+	unsigned long long z = ((unsigned long long)seed << 32 | stream) + 0x9E3779B97F4A7C15ULL;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	z = z ^ (z >> 31);
+	// xorshift has to start from a state that is not 0
+	_state = z != 0 ? z : 0x9E3779B97F4A7C15ULL;
+}
+
+unsigned long long SampleStream::next()
+{
+	_state ^= _state >> 12;
+	_state ^= _state << 25;
+	_state ^= _state >> 27;
+	return _state * 0x2545F4914F6CDD1DULL;
+}
+
+int SampleStream::uniform(int n)
+{
+	// the high bits are the best of xorshift64*
+	return (int)((next() >> 33) % (unsigned long long)n);
+}
+
+/*
+ * Implementation: DecaySampler
+ * ------------------------------
+ * The points are those polyFit takes: the years since the first assessment and the ratings.
+ */
+DecaySampler::DecaySampler(const ComponentRatingMat &ratings)
+{
+	int n = ratings.ratings.size();
+	vector<float> y(n);
+	_x.resize(n);
+	for (int i = 0; i < n; i++) {
+		_x[i] = ratings.years[i] - ratings.years[0];
+		y[i] = ratings.ratings[i];
+	}
+	PolyCoeffs fit = polyFit(ratings);
+	for (int k = 0; k < 3; k++)
+		_coeff[k] = fit.coeff[k];
+
+	double inflation = n > 3 ? sqrt((double)n/(n - 3)) : 1.0;
+	_fitted.resize(n);
+	_residuals.resize(n);
+	for (int i = 0; i < n; i++) {
+		_fitted[i] = (_coeff[0]*_x[i] + _coeff[1])*_x[i] + _coeff[2];
+		_residuals[i] = (float)((y[i] - _fitted[i])*inflation);
+	}
+}
+
+const float *DecaySampler::coefficients() const
+{
+	return _coeff;
+}
+
+bool DecaySampler::sample(SampleStream &random, int limit, int ratingsDecay[][10]) const
+{
+	int n = _x.size();
+	vector<float> y(n);
+	for (int i = 0; i < n; i++)
+		y[i] = _fitted[i] + _residuals[random.uniform(n)];
+
+	// the years are those of the fit, so the sampled quadratic is determined as well
+	PolyCoeffs fit = polyFit(&_x[0], &y[0], n);
+	const float *coeff = fit.coeff;
+	// a straight line has no roots for ratingDecay to take
+	if (coeff[0] == 0 || !(fabs(coeff[0]) < HUGE_VAL && fabs(coeff[1]) < HUGE_VAL && fabs(coeff[2]) < HUGE_VAL))
+		return false;
+
+	try {
+		ratingDecay(ratingsDecay, coeff, limit);
+	} catch (const BlackBoxError &) {
+		return false;
+	}
+	return true;
+}
+
+/*
+ * Implementation: summarizeSamples
+ * ------------------------------
+ *
+ */
+SampleSummary summarizeSamples(vector<float> values)
+{
+	SampleSummary summary;
+	summary.samples = values.size();
+	summary.mean = summary.stdDev = summary.minimum = summary.p5 = summary.median = summary.p95 = summary.maximum = 0;
+	if (values.empty())
+		return summary;
+
+	sort(values.begin(), values.end());
+	double sum = 0.0;
+	for (int i = 0; i < values.size(); i++)
+		sum += values[i];
+	double mean = sum/values.size();
+	double squares = 0.0;
+	for (int i = 0; i < values.size(); i++)
+		squares += (values[i] - mean)*(values[i] - mean);
+
+	int last = values.size() - 1;
+	summary.mean = (float)mean;
+	summary.stdDev = (float)sqrt(squares/values.size());
+	summary.minimum = values[0];
+	summary.p5 = values[(int)floor(0.05*last + 0.5)];
+	summary.median = values[(int)floor(0.5*last + 0.5)];
+	summary.p95 = values[(int)floor(0.95*last + 0.5)];
+	summary.maximum = values[last];
+	return summary;
+}
+
+/*
+ * Implementation: timingSpread
+ * ------------------------------
+ * Each sample is gone through once: its repairs are numbered by ID and looked up by
+ * (repairID, occurrence) among those of the schedule.
+ */
+vector<TimingSpread> timingSpread(const RepairSchedule &schedule, const vector<RepairSchedule> &samples)
+{
+	// (repairID, occurrence) -> index in the schedule
+	map<pair<int, int>, int> index;
+	map<int, int> occurrences;
+	for (int r = 0; r < schedule.size(); r++)
+		index[make_pair(schedule[r].repairID, occurrences[schedule[r].repairID]++)] = r;
+
+	int nRepairs = schedule.size();
+	vector<int> count(nRepairs, 0);
+	vector<double> sum(nRepairs, 0.0), squares(nRepairs, 0.0);
+	vector<TimingSpread> spread(nRepairs);
+	for (int r = 0; r < nRepairs; r++) {
+		spread[r].repairID = schedule[r].repairID;
+		spread[r].year = schedule[r].repairYear;
+		spread[r].earliest = spread[r].latest = 0;
+	}
+
+	for (int s = 0; s < samples.size(); s++) {
+		map<int, int> seen;
+		for (int k = 0; k < samples[s].size(); k++) {
+			const Pair &repair = samples[s][k];
+			map<pair<int, int>, int>::const_iterator match = index.find(make_pair(repair.repairID, seen[repair.repairID]++));
+			if (match == index.end())
+				continue;
+			int r = match->second;
+			if (count[r] == 0 || repair.repairYear < spread[r].earliest)
+				spread[r].earliest = repair.repairYear;
+			if (count[r] == 0 || repair.repairYear > spread[r].latest)
+				spread[r].latest = repair.repairYear;
+			count[r]++;
+			sum[r] += repair.repairYear;
+			squares[r] += (double)repair.repairYear*repair.repairYear;
+		}
+	}
+
+	for (int r = 0; r < nRepairs; r++) {
+		spread[r].frequency = samples.empty() ? 0.0f : (float)count[r]/samples.size();
+		spread[r].meanYear = spread[r].stdDevYear = 0;
+		if (count[r] > 0) {
+			double mean = sum[r]/count[r];
+			spread[r].meanYear = (float)mean;
+			spread[r].stdDevYear = (float)sqrt(max(squares[r]/count[r] - mean*mean, 0.0));
+		}
+	}
+	return spread;
+}
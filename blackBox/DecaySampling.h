@@ -0,0 +1,130 @@
+//
+//  DecaySampling.h
+//  blackBox
+//
+//  Deterioration curves sampled around the quadratic fit of a component's ratings,
+//  for the Monte Carlo solve of optScheduleUncertainty, and the statistics of its results.
+//
+
+#ifndef blackBox_DecaySampling_h
+#define blackBox_DecaySampling_h
+
+#include "FindOptSchedule.h"
+#include <vector>
+
+using namespace std;
+
+/*
+ * Class: SampleStream
+ * -----------------------------------------------------------------------------
+ * A stream of pseudo-random numbers (xorshift64*) that belongs to one task only, so that
+ * the tasks of a Monte Carlo solve draw without sharing a generator. The streams of one seed
+ * are told apart by "stream"; the same seed and stream always give the same numbers.
+ */
+class SampleStream {
+public:
+	SampleStream(unsigned int seed, unsigned int stream);
+
+	/*
+	 * Function: uniform
+	 * Usage: i = random.uniform(n);
+	 * -----------------------------------------------------------------------------
+	 * A number in 0 .. n-1, each as likely.
+	 */
+	int uniform(int n);
+
+private:
+	unsigned long long next();
+
+	unsigned long long _state;
+};
+
+/*
+ * Class: DecaySampler
+ * -----------------------------------------------------------------------------
+ * The quadratic fit of a component's ratings, as ratingDecay uses it, and its residuals.
+ * A sample resamples the residuals with replacement onto the fitted ratings (a residual
+ * bootstrap) and fits the curve again; the residuals are scaled by sqrt(n/(n-3)) so that
+ * their spread is not understated by the fit. The sampler is only read once built, so the
+ * tasks of a solve share it.
+ */
+class DecaySampler {
+public:
+	DecaySampler(const ComponentRatingMat &ratings);
+
+	/*
+	 * Function: coefficients
+	 * Usage: ratingDecay(ratingsDecay, sampler.coefficients(), limit);
+	 * -----------------------------------------------------------------------------
+	 * The coefficients a, b, c of the curve fitted to the ratings themselves.
+	 */
+	const float *coefficients() const;
+
+	/*
+	 * Function: sample
+	 * Usage: if (sampler.sample(random, limit, ratingsDecay)) ...
+	 * -----------------------------------------------------------------------------
+	 * Fills ratingsDecay as ratingDecay does, from a curve sampled with "random".
+	 * Returns false if the sampled curve does not cross every rating from 9 down to "limit",
+	 * the case where ratingDecay throws; the sample is then not used.
+	 */
+	bool sample(SampleStream &random, int limit, int ratingsDecay[][10]) const;
+
+private:
+	vector<float> _x;
+	vector<float> _fitted;
+	vector<float> _residuals;
+	float _coeff[3];
+};
+
+/*
+ * Struct: SampleSummary
+ * -----------------------------------------------------------------------------
+ * Distribution of the values of the samples; the percentiles are those of the nearest rank.
+ */
+struct SampleSummary {
+	int samples;
+	float mean;
+	float stdDev;
+	float minimum;
+	float p5;
+	float median;
+	float p95;
+	float maximum;
+};
+
+/*
+ * Struct: TimingSpread
+ * -----------------------------------------------------------------------------
+ * How one repair of a schedule moves over the samples. The n-th repair of an ID in the
+ * schedule is matched with the n-th repair of the same ID in each sample; frequency is the
+ * fraction of the samples that have it, and the years are those of the samples that do,
+ * all 0 if none does.
+ */
+struct TimingSpread {
+	int repairID;
+	int year;
+	float frequency;
+	float meanYear;
+	float stdDevYear;
+	int earliest;
+	int latest;
+};
+
+/*
+ * Function: summarizeSamples
+ * Usage: summary = summarizeSamples(values);
+ * -----------------------------------------------------------------------------
+ * The distribution of "values"; every field is 0 if there are none.
+ */
+SampleSummary summarizeSamples(vector<float> values);
+
+/*
+ * Function: timingSpread
+ * Usage: spread = timingSpread(schedule, samples);
+ * -----------------------------------------------------------------------------
+ * The spread of every repair of "schedule" over the schedules of the samples, in its order.
+ */
+vector<TimingSpread> timingSpread(const RepairSchedule &schedule, const vector<RepairSchedule> &samples);
+
+#endif
@@ -8,202 +8,325 @@
 
 #include <iostream>
 #include <math.h>
-#include <set>
 #include "EnvImpact.h"
 #include <limits>
 
+/* 
+ * calculations fall in to 11 categories depending on its repairID; each has its own equation.
+ * repairCategory[repairID] gives the category, 0 means the repair has no equation.
+ * 45 is not in category three: the original crewID 45 was removed.
+ */
+static const int repairCategory[] = {
+	11,  1,  2,  3,  4,  5,  6,  1,  7,  7,		//  0 -  9
+	 4,  8,  9,  9,  9,  1,  1, 10, 10, 10,		// 10 - 19
+	10, 10,  3,  3,  3,  3,  3,  3,  3,  3,		// 20 - 29
+	 3,  3,  3,  3,  3, 10, 10,  6,  6,  6,		// 30 - 39
+	 6,  7,  7,  7,  7,  0,  7,  7,  7,  7,		// 40 - 49
+	 7,  8										// 50 - 51
+};
+static const int nCategoryIDs = sizeof(repairCategory)/sizeof(repairCategory[0]);
+
 /*
- * Function: calCO2
- * Usage: calCO2(bridgeInfo, year, repairID, conditionRating, repairCO2);
+ * Function: yearFactorsCompiler
+ * Usage: factors = yearFactorsCompiler(bridge, bridge.nYears);
  * ----------------------------------------------------------------------
- * Calculate the C02 for given repair info;
+ * The only pow() calls of a request; the DP and calEnvImpact read the factors from here.
+ */
+YearFactors yearFactorsCompiler(const BridgeInfo &bridge, int nYears) {
+	YearFactors factors;
+	factors.nYears = nYears;
+	factors.growth.resize(nYears);
+	factors.discount.resize(nYears);
+
+	float growthRate = bridge.trafficGrowthRate;
+	float r = bridge.discountRate;
+	for (int year = 0; year < nYears; year++) {
+		factors.growth[year] = pow(1+growthRate, year);
+		factors.discount[year] = pow(r+1, year);
+	}
+
+	return factors;
+}
+
+/*
+ * Function: envFormulaCompiler
+ * Usage: formulas = envFormulaCompiler(bridge, repairs, impMat);
+ * ----------------------------------------------------------------------
+ * Resolves the category of every repairID and, for each rating, the first entry of repairs
+ * whose [LB, UB] band contains it, so that calEnvImpact needs no search.
  * BridgeInfo: [0]Length, [1]Width, [2]ADDT, [3]ADDTT, [4]Traffic Growth Rate, [5]discount rate 
  * RepairEnMat: [0]repairID, [1]improvement, [2]condition rating, [3]meanRepair, [4]meanTraffic, [5]days of repair, 
  * ImproveMat: improvement coefficient
- * Exceptions are hard coded here
  */
-float calEnvImpact(BridgeInfo bridge, int year, int repairID, int rating, RepairEnvMat repairs, ImproveMat impMat) {
-    float deckLength = bridge.bridgeLength;
-    float deckWidth = bridge.bridgeWidth;
-    float AADT = bridge.bridgeAADT;
-    float growthRate = bridge.trafficGrowthRate;
-    // int nSpan = bridgeInfo[6];
-    float meanRepair;
-    float meanTraffic;
-    int days;
-    float impCoeff;
-
-	for ( int i = 0; i < impMat.size(); i++ ) {
-		if (impMat[i].condition == rating)
-			impCoeff = impMat[i].coef;
+EnvFormulaTable envFormulaCompiler(const BridgeInfo &bridge, const RepairEnvMat &repairs, const ImproveMat &impMat) {
+	EnvFormulaTable formulas;
+	formulas.deckLength = bridge.bridgeLength;
+	formulas.deckWidth = bridge.bridgeWidth;
+	formulas.AADT = bridge.bridgeAADT;
+
+	formulas.nRatings = 10;
+	for (int rating = 0; rating < formulas.nRatings; rating++) {
+		formulas.impCoeff[rating] = 0.0f;
+		for (int i = 0; i < impMat.size(); i++) {
+			if (impMat[i].condition == rating)
+				formulas.impCoeff[rating] = impMat[i].coef;
+		}
+	}
+
+	formulas.nRepairIDs = nCategoryIDs;
+	for (int j = 0; j < repairs.size(); j++) {
+		if (repairs[j].repairID >= formulas.nRepairIDs)
+			formulas.nRepairIDs = repairs[j].repairID + 1;
 	}
 
-   /* float CO2 = numeric_limits<float>::infinity();*/
+	int size = formulas.nRepairIDs*formulas.nRatings;
+	formulas.category.assign(formulas.nRepairIDs, 0);
+	formulas.resolved.assign(size, 0);
+	formulas.repairMean.assign(size, 0.0f);
+	formulas.trafficMean.assign(size, 0.0f);
+	formulas.duration.assign(size, 0);
+
+	for (int id = 0; id < nCategoryIDs; id++)
+		formulas.category[id] = repairCategory[id];
+
+	for (int j = 0; j < repairs.size(); j++) {
+		if (repairs[j].repairID < 0)
+			continue;
+		for (int rating = 0; rating < formulas.nRatings; rating++) {
+			int idx = repairs[j].repairID*formulas.nRatings + rating;
+			if (formulas.resolved[idx] || rating > repairs[j].UB || rating < repairs[j].LB)
+				continue;
+			formulas.resolved[idx] = 1;
+			formulas.repairMean[idx] = repairs[j].repairMean;
+			formulas.trafficMean[idx] = repairs[j].trafficMean;
+			formulas.duration[idx] = repairs[j].duration;
+		}
+	}
+
+	return formulas;
+}
+
+/*
+ * Function: calCO2
+ * Usage: calEnvImpact(formulas, factors, year, repairID, conditionRating);
+ * ----------------------------------------------------------------------
+ * Calculate the C02 for given repair info;
+ * Exceptions are hard coded here
+ */
+float calEnvImpact(const EnvFormulaTable &formulas, const YearFactors &factors, int year, int repairID, int rating) {
+    if (repairID < 0 || repairID >= formulas.nRepairIDs || rating < 0 || rating >= formulas.nRatings)
+        return 0.0f;
+
+    int idx = repairID*formulas.nRatings + rating;
+    if (!formulas.resolved[idx])
+        return 0.0f;
+
+    float deckLength = formulas.deckLength;
+    float deckWidth = formulas.deckWidth;
+    float AADT = formulas.AADT;
+    float growth = factors.growth[year];
+    float meanRepair = formulas.repairMean[idx];
+    float meanTraffic = formulas.trafficMean[idx];
+    int days = formulas.duration[idx];
+    float impCoeff = formulas.impCoeff[rating];
+
 	float CO2 = 0.0f;
-	float randomName = 0.0f;
-    
-    /* calculations fall in to 11 categories depending on its repairID; each has its own equation */
-    int categoryOne[] = {1, 7 , 15, 16};
-    set<int> one(categoryOne,categoryOne+4);
-    int categoryTwo[] = {2};
-    set<int> two(categoryTwo,categoryTwo+1);
-    int categoryThree[] = {3, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34,45};
-    set<int> three(categoryThree,categoryThree+14);
-    int categoryFour[] = {4, 10};
-    set<int> four(categoryFour, categoryFour+2);
-    int categoryFive[] = {5};
-    set<int> five(categoryFive,categoryFive+1);
-    int categorySix[] = {6, 37, 38, 39, 40};
-    set<int> six(categorySix, categorySix+5);
-    int categorySeven[] = {8, 9, 41, 42, 43, 44, 46, 47, 48, 49, 50};
-    set<int> seven(categorySeven, categorySeven+11);
-    int categoryEight[] = { 11, 51 }; //need to be modified
-    set<int> eight(categoryEight, categoryEight+2); 
-    int categoryNine[] = {12, 13, 14};
-    set<int> nine(categoryNine, categoryNine+3);
-    int categoryTen[] = {17, 18 ,19, 20, 21, 35, 36};
-    set<int> ten(categoryTen, categoryTen+ 7);
-    int categoryEleven[] = {0}; // original crewID 45 was removed
-    set<int> eleven(categoryEleven, categoryEleven +1 );
-    
-    if (one.count(repairID) == 1) {
-        
-        for (int j = 0; j < repairs.size() ; j++) {
-            if (repairs[j].repairID == repairID && (rating <= repairs[j].UB && rating >= repairs[j].LB) ) {
-                meanRepair = repairs[j].repairMean;
-                meanTraffic= repairs[j].trafficMean;
-                days = repairs[j].duration;
-
-                CO2 = meanRepair*deckLength*deckWidth*impCoeff + meanTraffic*AADT*days*pow(1+growthRate, year);
-                break;
-            }
-        } 
-        
-	} else if(two.count(repairID) == 1) {
-        
-        for (int j = 0; j < repairs.size() ; j++) {
-            if (repairs[j].repairID == repairID && (rating <= repairs[j].UB && rating >= repairs[j].LB) ) {
-                meanRepair = repairs[j].repairMean;
-                meanTraffic= repairs[j].trafficMean;
-                days = repairs[j].duration;
-
-                CO2 = meanRepair* 10 * deckWidth*impCoeff + meanTraffic*AADT*days*pow(1+growthRate, year);
-                return CO2;
-            }
-        }
-        
-    } else if(three.count(repairID) == 1) {
-        
-        for (int j = 0; j < repairs.size() ; j++) {
-            if (repairs[j].repairID == repairID && (rating <= repairs[j].UB && rating >= repairs[j].LB) ) {
-                meanRepair = repairs[j].repairMean;
-                meanTraffic= repairs[j].trafficMean;
-                days = repairs[j].duration;
-
-                CO2 = meanRepair * deckWidth * meanTraffic * AADT * days * pow(1+growthRate, year);
-                break;
-            } 
-        }
-        
-    } else if(four.count(repairID) == 1) {
-        
-        for (int j = 0; j < repairs.size() ; j++) {
-			 if (repairs[j].repairID == repairID && (rating <= repairs[j].UB && rating >= repairs[j].LB) ) {
-                meanRepair = repairs[j].repairMean;
-                meanTraffic= repairs[j].trafficMean;
-                days = repairs[j].duration;
-
-                CO2 = meanRepair*deckLength* 2 * impCoeff;
-                break;
-             }  
-        }
-        
-    } else if(five.count(repairID) == 1) {
-        
-        for (int j = 0; j < repairs.size() ; j++) {
-            if (repairs[j].repairID == repairID && (rating <= repairs[j].UB && rating >= repairs[j].LB) ) {
-                meanRepair = repairs[j].repairMean;
-                meanTraffic= repairs[j].trafficMean;
-                days = repairs[j].duration;
-
-                CO2 = meanRepair*deckLength*deckWidth;
-                break;
-            }
-        } 
-        
-    } else if(six.count(repairID) == 1) {
-        
-        for (int j = 0; j < repairs.size() ; j++) {
-            if (repairs[j].repairID == repairID && (rating <= repairs[j].UB && rating >= repairs[j].LB) ) {
-                meanRepair = repairs[j].repairMean;
-                meanTraffic= repairs[j].trafficMean;
-                days = repairs[j].duration;
-                CO2 = meanRepair*deckLength*deckWidth*impCoeff;
-                break;
-            }
-        } 
-        
-    } else if(seven.count(repairID) == 1) {
-        // no information available
-        CO2 = 0;
-        
-    } else if(eight.count(repairID) == 1) {
-        
-        for (int j = 0; j < repairs.size() ; j++) {
-            if (repairs[j].repairID == repairID && (rating <= repairs[j].UB && rating >= repairs[j].LB) ) {
-                meanRepair = repairs[j].repairMean;
-                meanTraffic= repairs[j].trafficMean;
-                days = repairs[j].duration;
-                // warning: this need to be modified
-                CO2 = meanRepair;
-                break;
-            }
-        } 
 
-        
-    } else if(nine.count(repairID) == 1) {
-        
-        for (int j = 0; j < repairs.size() ; j++) {
-            if (repairs[j].repairID == repairID && (rating <= repairs[j].UB && rating >= repairs[j].LB) ) {
-                meanRepair = repairs[j].repairMean;
-                meanTraffic= repairs[j].trafficMean;
-                days = repairs[j].duration;
-                CO2 = meanRepair*deckLength*2*impCoeff*meanTraffic*AADT*days*pow(1+growthRate, year);
-                break;
-            }
-        }  
-        
-    } else if(ten.count(repairID) == 1) {
-        
-        for (int j = 0; j < repairs.size() ; j++) {
-            if (repairs[j].repairID == repairID && (rating <= repairs[j].UB && rating >= repairs[j].LB) ) {
-                meanRepair = repairs[j].repairMean;
-                meanTraffic= repairs[j].trafficMean;
-                days = repairs[j].duration;
-                CO2 = meanRepair*deckLength*deckWidth + meanTraffic*AADT*days*pow(1+growthRate, year);
-                break;
-            }
-        } 
-      
-    } else if(eleven.count(repairID) == 1) {
-        
-        for (int j = 0; j < repairs.size() ; j++) {
-            if (repairs[j].repairID == repairID && (rating <= repairs[j].UB && rating >= repairs[j].LB) ) {
-                meanRepair = repairs[j].repairMean;
-                meanTraffic= repairs[j].trafficMean;
-                days = repairs[j].duration;
-                CO2 = meanRepair*deckLength*deckWidth*impCoeff * meanTraffic*AADT*days*pow(1+growthRate, year);
-                break;
-            }
-        } 
+    switch (formulas.category[repairID]) {
+        case 1:
+            CO2 = meanRepair*deckLength*deckWidth*impCoeff + meanTraffic*AADT*days*growth;
+            break;
+        case 2:
+            CO2 = meanRepair* 10 * deckWidth*impCoeff + meanTraffic*AADT*days*growth;
+            break;
+        case 3:
+            CO2 = meanRepair * deckWidth * meanTraffic * AADT * days * growth;
+            break;
+        case 4:
+            CO2 = meanRepair*deckLength* 2 * impCoeff;
+            break;
+        case 5:
+            CO2 = meanRepair*deckLength*deckWidth;
+            break;
+        case 6:
+            CO2 = meanRepair*deckLength*deckWidth*impCoeff;
+            break;
+        case 7:
+            // no information available
+            CO2 = 0;
+            break;
+        case 8:
+            // warning: this need to be modified
+            CO2 = meanRepair;
+            break;
+        case 9:
+            CO2 = meanRepair*deckLength*2*impCoeff*meanTraffic*AADT*days*growth;
+            break;
+        case 10:
+            CO2 = meanRepair*deckLength*deckWidth + meanTraffic*AADT*days*growth;
+            break;
+        case 11:
+            CO2 = meanRepair*deckLength*deckWidth*impCoeff * meanTraffic*AADT*days*growth;
+            break;
     }
     
-    
     return CO2;
 }
 
 
 
+/*
+ * Function: weightedFormulaCompiler
+ * Usage: formulas = weightedFormulaCompiler(bridge, repairs, weights, impMat);
+ * ----------------------------------------------------------------------
+ * The slots of each objective are resolved by envFormulaCompiler, then gathered so that the
+ * coefficients of one slot are contiguous for the dot products.
+ */
+WeightedFormulaTable weightedFormulaCompiler(const BridgeInfo &bridge, const vector<RepairEnvMat> &repairs, const vector<float> &weights, const ImproveMat &impMat) {
+	int nObjectives = repairs.size();
+	vector<EnvFormulaTable> tables(nObjectives);
+	int first = -1;
+	for (int o = 0; o < nObjectives; o++) {
+		if (weights[o] == 0)
+			continue;
+		tables[o] = envFormulaCompiler(bridge, repairs[o], impMat);
+		if (first < 0)
+			first = o;
+	}
+	if (first < 0)
+		throw BlackBoxError("No objective to optimize");
+
+	WeightedFormulaTable formulas;
+	formulas.deckLength = tables[first].deckLength;
+	formulas.deckWidth = tables[first].deckWidth;
+	formulas.AADT = tables[first].AADT;
+	for (int rating = 0; rating < 10; rating++)
+		formulas.impCoeff[rating] = tables[first].impCoeff[rating];
+
+	formulas.nObjectives = nObjectives;
+	formulas.nRatings = tables[first].nRatings;
+	formulas.nRepairIDs = 0;
+	for (int o = 0; o < nObjectives; o++) {
+		if (weights[o] != 0 && tables[o].nRepairIDs > formulas.nRepairIDs)
+			formulas.nRepairIDs = tables[o].nRepairIDs;
+	}
+	formulas.weights = weights;
+	formulas.category = tables[first].category;
+	formulas.category.resize(formulas.nRepairIDs, 0);
+
+	int size = formulas.nRepairIDs*formulas.nRatings;
+	formulas.resolved.assign(size, 1);
+	formulas.duration.assign(size, 0);
+	formulas.repairMean.assign(size*nObjectives, 0.0f);
+	formulas.trafficMean.assign(size*nObjectives, 0.0f);
+	for (int o = 0; o < nObjectives; o++) {
+		if (weights[o] == 0)
+			continue;
+		for (int slot = 0; slot < size; slot++) {
+			if (slot >= tables[o].resolved.size() || !tables[o].resolved[slot]) {
+				formulas.resolved[slot] = 0;
+				continue;
+			}
+			formulas.repairMean[slot*nObjectives + o] = tables[o].repairMean[slot];
+			formulas.trafficMean[slot*nObjectives + o] = tables[o].trafficMean[slot];
+			formulas.duration[slot] = tables[o].duration[slot];
+		}
+	}
+
+	// the cost is weighted apart, its values are scaled by the repair cost of each request
+	int cost = nObjectives-1;
+	vector<float> envWeights(weights);
+	envWeights[cost] = 0.0f;
+
+	formulas.repairSum.assign(size, 0.0f);
+	formulas.trafficSum.assign(size, 0.0f);
+	formulas.productSum.assign(size, 0.0f);
+	formulas.costRepair.assign(size, 0.0f);
+	formulas.costTraffic.assign(size, 0.0f);
+	formulas.costProduct.assign(size, 0.0f);
+	for (int slot = 0; slot < size; slot++) {
+		if (!formulas.resolved[slot])
+			continue;
+		const float *repairMean = &formulas.repairMean[slot*nObjectives];
+		const float *trafficMean = &formulas.trafficMean[slot*nObjectives];
+		float repairSum = 0.0f, trafficSum = 0.0f, productSum = 0.0f;
+		for (int o = 0; o < nObjectives; o++) {
+			repairSum += envWeights[o]*repairMean[o];
+			trafficSum += envWeights[o]*trafficMean[o];
+			productSum += envWeights[o]*repairMean[o]*trafficMean[o];
+		}
+		formulas.repairSum[slot] = repairSum;
+		formulas.trafficSum[slot] = trafficSum;
+		formulas.productSum[slot] = productSum;
+		formulas.costRepair[slot] = weights[cost]*repairMean[cost];
+		formulas.costTraffic[slot] = weights[cost]*trafficMean[cost];
+		formulas.costProduct[slot] = weights[cost]*repairMean[cost]*trafficMean[cost];
+	}
+
+	return formulas;
+}
+
+/*
+ * Function: calWeightedImpact
+ * Usage: calWeightedImpact(formulas, factors, year, repairID, conditionRating, repairCost);
+ * ----------------------------------------------------------------------
+ * The formulas of calEnvImpact, written as a*meanRepair + b*meanTraffic + c*meanRepair*meanTraffic.
+ */
+float calWeightedImpact(const WeightedFormulaTable &formulas, const YearFactors &factors, int year, int repairID, int rating, float repairCost) {
+	if (repairID < 0 || repairID >= formulas.nRepairIDs || rating < 0 || rating >= formulas.nRatings)
+		return 0.0f;
+
+	int idx = repairID*formulas.nRatings + rating;
+	if (!formulas.resolved[idx])
+		return 0.0f;
+
+	float deckLength = formulas.deckLength;
+	float deckWidth = formulas.deckWidth;
+	float impCoeff = formulas.impCoeff[rating];
+	float traffic = formulas.AADT*formulas.duration[idx]*factors.growth[year];
+
+	float a = 0.0f, b = 0.0f, c = 0.0f;
+	switch (formulas.category[repairID]) {
+		case 1:
+			a = deckLength*deckWidth*impCoeff;
+			b = traffic;
+			break;
+		case 2:
+			a = 10*deckWidth*impCoeff;
+			b = traffic;
+			break;
+		case 3:
+			c = deckWidth*traffic;
+			break;
+		case 4:
+			a = deckLength*2*impCoeff;
+			break;
+		case 5:
+			a = deckLength*deckWidth;
+			break;
+		case 6:
+			a = deckLength*deckWidth*impCoeff;
+			break;
+		case 8:
+			a = 1;
+			break;
+		case 9:
+			c = deckLength*2*impCoeff*traffic;
+			break;
+		case 10:
+			a = deckLength*deckWidth;
+			b = traffic;
+			break;
+		case 11:
+			c = deckLength*deckWidth*impCoeff*traffic;
+			break;
+	}
+
+	float env = a*formulas.repairSum[idx] + b*formulas.trafficSum[idx] + c*formulas.productSum[idx];
+	float cost = a*formulas.costRepair[idx] + b*formulas.costTraffic[idx] + c*formulas.costProduct[idx];
+	return env + cost*repairCost/factors.discount[year];
+}
+
 /*
  * Function: calTotalCO2
  * Usage: calTotalCO2( bridgeInfo, optSchedule, repairCO2);
@@ -11,9 +11,115 @@
 
 #include "Input.h"
 
+/*
+ * Struct: YearFactors
+ * -------------------
+ * Traffic growth and discount factors for years 0..nYears-1 of a request:
+ * growth[year] = (1+trafficGrowthRate)^year and discount[year] = (1+discountRate)^year.
+ * Computed once and shared by the environmental and cost engines.
+ */
+struct YearFactors {
+	int nYears;
+	vector<float> growth;
+	vector<float> discount;
+};
+
+/*
+ * Struct: EnvFormulaTable
+ * -----------------------
+ * Everything calEnvImpact needs, resolved once per RepairEnvMat.
+ * category[repairID] is the formula (1-11, 0 if none) used for the repair, and
+ * repairMean/trafficMean/duration[repairID*nRatings + rating] hold the coefficients of the
+ * repair entry whose [LB, UB] band contains "rating" (resolved is 0 if there is none).
+ */
+struct EnvFormulaTable {
+	float deckLength;
+	float deckWidth;
+	float AADT;
+	float impCoeff[10];
+
+	int nRepairIDs;
+	int nRatings;
+	vector<int> category;
+	vector<char> resolved;
+	vector<float> repairMean;
+	vector<float> trafficMean;
+	vector<int> duration;
+};
+
+/*
+ * Struct: WeightedFormulaTable
+ * ----------------------------
+ * Everything calWeightedImpact needs for a weighted sum of the objectives 1-11, resolved once
+ * per request. The coefficients of all the objectives are kept together for each slot
+ * repairID*nRatings + rating: repairMean/trafficMean[slot*nObjectives + objective].
+ * repairSum, trafficSum and productSum[slot] are their dot products (meanRepair, meanTraffic and
+ * meanRepair*meanTraffic) with the weights of the environmental objectives, and costRepair,
+ * costTraffic and costProduct the same terms of the cost, weighted. resolved is 1 where every
+ * objective with a weight has coefficients.
+ */
+struct WeightedFormulaTable {
+	float deckLength;
+	float deckWidth;
+	float AADT;
+	float impCoeff[10];
+
+	int nObjectives;
+	int nRepairIDs;
+	int nRatings;
+	vector<float> weights;
+	vector<int> category;
+	vector<char> resolved;
+	vector<int> duration;
+	vector<float> repairMean;
+	vector<float> trafficMean;
+
+	vector<float> repairSum;
+	vector<float> trafficSum;
+	vector<float> productSum;
+	vector<float> costRepair;
+	vector<float> costTraffic;
+	vector<float> costProduct;
+};
+
 /* function prototype */
 
-float calEnvImpact(BridgeInfo bridge, int year, int repairID, int rating, RepairEnvMat repairs, ImproveMat impMat);
+/*
+ * Function: yearFactorsCompiler
+ * Usage: factors = yearFactorsCompiler(bridge, bridge.nYears);
+ * ----------------------------------------------------------------------
+ * Evaluates the growth and discount factors of every year of the planning horizon.
+ */
+YearFactors yearFactorsCompiler(const BridgeInfo &bridge, int nYears);
+
+/*
+ * Function: envFormulaCompiler
+ * Usage: formulas = envFormulaCompiler(bridge, repairs, impMat);
+ * ----------------------------------------------------------------------
+ * Builds the lookup table used by calEnvImpact for the given bridge and repairs.
+ */
+EnvFormulaTable envFormulaCompiler(const BridgeInfo &bridge, const RepairEnvMat &repairs, const ImproveMat &impMat);
+
+float calEnvImpact(const EnvFormulaTable &formulas, const YearFactors &factors, int year, int repairID, int rating);
+
+/*
+ * Function: weightedFormulaCompiler
+ * Usage: formulas = weightedFormulaCompiler(bridge, repairs, weights, impMat);
+ * ----------------------------------------------------------------------
+ * Builds the lookup table used by calWeightedImpact. repairs[o] and weights[o] are the repairs and the
+ * weight of objective o+1; the last one is the cost. The repairs of an objective without weight are not read.
+ */
+WeightedFormulaTable weightedFormulaCompiler(const BridgeInfo &bridge, const vector<RepairEnvMat> &repairs, const vector<float> &weights, const ImproveMat &impMat);
+
+/*
+ * Function: calWeightedImpact
+ * Usage: calWeightedImpact(formulas, factors, year, repairID, conditionRating, repairCost);
+ * ----------------------------------------------------------------------
+ * The weighted sum of calEnvImpact over the objectives, the cost being scaled by repairCost and
+ * discounted as in findOptCostSchedule. Every formula is linear in meanRepair, meanTraffic and their
+ * product, so the sum is taken from the dot products of the table instead of one calEnvImpact per objective.
+ */
+float calWeightedImpact(const WeightedFormulaTable &formulas, const YearFactors &factors, int year, int repairID, int rating, float repairCost);
 //float calTotalCO2(float bridgeInfo[10], int optSchedule[][3], float repairCO2[][7]);
 
 #endif
@@ -4,35 +4,158 @@
 #include <sstream>
 #include <iomanip>
 #include <limits>
+#include <algorithm>
 #include <set>
 #include "FindOptSchedule.h"
 #include "EnvImpact.h"
-/* 
- * Function: findOptEnvSchedule
- * Usage: findOptEnvSchedule(bridgeInfo, ratingsDecay, reparis, repairs, impMat, optSchedule);
- * -----------------------------------------------------------------------------------------------------------
- * This function generates a optimal schedule for environmental impact by using a dynamic programing algorithm.
- * Returns the minimum envImpact
+#include "AllocationCounter.h"
+#include "Logger.h"
+
+/*
+ * Implementation: repairBuckets
+ * ------------------------------------
+ * Groups the repairs by the transition they make: bucket [fromRating*nRatings + toRating] lists,
+ * in their order in "repairs", the repairs whose [LB, UB] band holds fromRating and whose
+ * improvement lifts it to toRating. The table compilers then only look at the feasible repairs.
+ */
+static vector<vector<int> > repairBuckets(const RepairEnvMat &repairs, int nRatings, int limit) {
+	vector<vector<int> > buckets(nRatings*nRatings);
+	for (int k = 0; k < repairs.size(); k++) {
+		int lb = max(repairs[k].LB, limit);
+		int ub = min(repairs[k].UB, nRatings-1);
+		for (int j = lb; j <= ub; j++) {
+			int i = j + repairs[k].improvement;
+			if (i > j && i < nRatings)
+				buckets[j*nRatings + i].push_back(k);
+			// repairs with improvement 7 restore any rating to 7
+			if (repairs[k].improvement == 7 && i != 7 && 7 > j && 7 < nRatings)
+				buckets[j*nRatings + 7].push_back(k);
+		}
+	}
+	return buckets;
+}
+
+/*
+ * Implementation: repairCostTableCompiler
+ * ------------------------------------
+ * A repair can lift "fromRating" to "toRating" if "fromRating" is in its [LB, UB] band and its
+ * improvement equals the rating gain; repairs with improvement 7 restore any rating to 7.
+ * Only the first repair reaching the minimum is kept, as the DP did when it scanned them.
+ * The table is sized by the horizon and rating scale of "bridge"; "factors" must cover bridge.nYears years.
+ */
+template <class Objective, class Formulas>
+static RepairCostTable repairCostTableCompiler(const BridgeInfo &bridge, const RepairEnvMat &repairs, const Objective &objective, const Formulas &formulas, const YearFactors &factors, int limit) {
+	RepairCostTable table;
+	table.nYears = bridge.nYears;
+	table.nRatings = bridge.nRatings;
+	table.cost.assign(table.nYears*table.nRatings*table.nRatings, numeric_limits<float>::infinity());
+	table.repairID.assign(table.nYears*table.nRatings*table.nRatings, 0);
+
+	vector<vector<int> > buckets = repairBuckets(repairs, table.nRatings, limit);
+	for (int year = 0; year < table.nYears; year++) {
+		for (int j = limit; j < table.nRatings; j++) {
+			for (int i = j+1; i < table.nRatings; i++) {
+				int idx = table.index(year, j, i);
+				const vector<int> &bucket = buckets[j*table.nRatings + i];
+				for (int b = 0; b < bucket.size(); b++) {
+					int k = bucket[b];
+					float tempRepairCost = objective.value(formulas, factors, year, k, repairs[k].repairID, j);
+					if (tempRepairCost < table.cost[idx]) {
+						table.repairID[idx] = repairs[k].repairID;
+						table.cost[idx] = tempRepairCost;
+					}
+				}
+			}
+		}
+	}
+
+	return table;
+}
+
+/*
+ * Implementation: CostObjective
+ * ------------------------------------
+ * The user's cost of each repair is looked up once, 0 if none was given.
+ */
+CostObjective::CostObjective(const RepairEnvMat &repairs, const CostMap &costs) : repairCosts(repairs.size(), 0.0f) {
+	for (int k = 0; k < repairs.size(); k++) {
+		CostMap::const_iterator cost = costs.find(repairs[k].repairID);
+		if (cost != costs.end())
+			repairCosts[k] = cost->second;
+	}
+}
+
+/*
+ * Implementation: envCostTableCompiler
+ * ------------------------------------
+ *
+ */
+RepairCostTable envCostTableCompiler(const BridgeInfo &bridge, const RepairEnvMat &repairs, const ImproveMat &impMat, const YearFactors &factors, int limit) {
+	return repairCostTableCompiler(bridge, repairs, EnvObjective(), envFormulaCompiler(bridge, repairs, impMat), factors, limit);
+}
+
+/*
+ * Implementation: costTableCompiler
+ * ---------------------------------
+ *
+ */
+RepairCostTable costTableCompiler(const BridgeInfo &bridge, const RepairEnvMat &repairs, const CostMap &costs, const ImproveMat &impMat, const YearFactors &factors, int limit) {
+	return repairCostTableCompiler(bridge, repairs, CostObjective(repairs, costs), envFormulaCompiler(bridge, repairs, impMat), factors, limit);
+}
+
+/*
+ * Implementation: weightedCostTableCompiler
+ * ---------------------------------
+ *
  */
-float findOptEnvSchedule(BridgeInfo bridge, int ratingsDecay[][10], RepairEnvMat repairs, ImproveMat impMat, int limit, RepairSchedule &optSchedule) {
+RepairCostTable weightedCostTableCompiler(const BridgeInfo &bridge, const vector<RepairEnvMat> &repairs, const vector<float> &weights, const CostMap &costs, const ImproveMat &impMat, const YearFactors &factors, int limit) {
+	if (weights.size() != repairs.size())
+		throw BlackBoxError("One weight is needed for every objective");
+
+	int first = -1;
+	for (int o = 0; o < weights.size(); o++) {
+		if (weights[o] < 0)
+			throw BlackBoxError("The weights of the objectives must not be negative");
+		if (weights[o] > 0 && first < 0)
+			first = o;
+	}
+	if (first < 0)
+		throw BlackBoxError("No objective to optimize");
+
+	WeightedFormulaTable formulas = weightedFormulaCompiler(bridge, repairs, weights, impMat);
+	return repairCostTableCompiler(bridge, repairs[first], WeightedObjective(repairs[first], costs), formulas, factors, limit);
+}
+
+/*
+ * Implementation: findOptSchedule
+ * ------------------------------------
+ * The DP kernel shared by the objectives. Objective::minGain and Objective::improves are
+ * compile-time constants of the policy, so each instantiation has its own inner loop.
+ */
+template <class Objective>
+static float findOptSchedule(const BridgeInfo &bridge, int ratingsDecay[][10], const RepairCostTable &table, int limit, RepairSchedule &optSchedule, const string &reportFile, ConditionFrontier *frontier = 0) {
     
+	// the horizon and the rating scale of the DP are those of the table
+	int nYears = table.nYears;
+	int nRatings = table.nRatings;
+
     //record the track to the target M[x][y] by memorizing its precessors
-    int preX[101][9],preY[101][9],preRepair[101][9];
+    StateGrid<int> preX(nYears, nRatings, -1), preY(nYears, nRatings, 0), preRepair(nYears, nRatings, 0);
     
     //M[x][y] is the best cost achived so far for year "x" to get rating of "y"
-    float M[101][9];
-    //Initialization of M
-    for(int i=0; i<101; i++)
-        for(int j=0; j<9;j++)
-            M[i][j]=0;
+    StateGrid<float> M(nYears, nRatings, 0);
   
 	int startRating = bridge.startRating;
 
+	// from here to the end of the fill nothing is allocated; COUNT_ALLOCATIONS builds report it
+#ifdef COUNT_ALLOCATIONS
+	long allocationsBefore = threadAllocations();
+#endif
 
     //boundary conditions
     for(int rating = startRating-1; rating >limit-1; rating--) {
-        for (int year = ratingsDecay[startRating][rating+1]; year <= ratingsDecay[startRating][rating];year++){
-            for(int i = 8; i> 0; i--){
+        for (int year = ratingsDecay[startRating][rating+1]; year <= ratingsDecay[startRating][rating] && year < nYears;year++){
+            for(int i = nRatings-1; i> 0; i--){
                 if (i >= rating)
                     M[year][i] = 0;
                 else
@@ -51,10 +174,10 @@ float findOptEnvSchedule(BridgeInfo bridge, int ratingsDecay[][10], RepairEnvMat
 	//cout << "output3:" <<   calEnvImpact(bridge, 0, repairs[0].repairID, 6, repairs, impMat) << endl;
 
     /* fill in the two dimension array M[x][y] is the best cost achived so far for year "x" to get rating of "y" */
-    for(int year=0;year<101; year++){
+    for(int year=0;year<nYears; year++){
         
         
-        for(int rating=limit; rating<9; rating++ ){
+        for(int rating=limit; rating<nRatings; rating++ ){
             // boundary condition that has been defined previously
             if ( rating <= startRating && ratingsDecay[startRating][rating] >= year){
 
@@ -67,7 +190,7 @@ float findOptEnvSchedule(BridgeInfo bridge, int ratingsDecay[][10], RepairEnvMat
                 float min= numeric_limits<float>::infinity();
                 float tempCost=0;
                 
-                for(int i=rating+1;i<9;i++){//i = rating, or i = rating+1 control whether year can be equal to yearDecay
+                for(int i=rating+Objective::minGain;i<nRatings;i++){//i = rating, or i = rating+1 control whether year can be equal to yearDecay
 
                     int yearDecay=year-ratingsDecay[i][rating];
 					// repairs can not happen before the startYear
@@ -78,32 +201,19 @@ float findOptEnvSchedule(BridgeInfo bridge, int ratingsDecay[][10], RepairEnvMat
                     int repairId=0;
                     
                     for (int j=limit;j<i;j++){
-                        for (int k=0;k<repairs.size();k++){
-							float tempRepairCost;
-		
-							// improve rating to certain level, the condition is hard-coded
-							if (i == 7 && repairs[k].improvement == 7 && (j <= repairs[k].UB && j >= repairs[k].LB)) {
-								tempRepairCost = calEnvImpact(bridge, yearDecay, repairs[k].repairID, j, repairs, impMat);
-								if (tempRepairCost < repairCost) {
-									repairId = repairs[k].repairID;
-									repairCost = tempRepairCost;
-								}
-							} else if (repairs[k].improvement==i-j && (j <= repairs[k].UB && j >= repairs[k].LB) ) {								
-                        	    // improve rating by certain level
-                                tempRepairCost = calEnvImpact(bridge, yearDecay, repairs[k].repairID, j, repairs, impMat);
-								if (tempRepairCost < repairCost) {
-									repairId = repairs[k].repairID;
-									repairCost = tempRepairCost;
-								}
-							} 
-                        }
+						// cheapest repair lifting "j" to "i" in yearDecay, precomputed
+						int idx = table.index(yearDecay, j, i);
+						if (table.cost[idx] < repairCost) {
+							repairId = table.repairID[idx];
+							repairCost = table.cost[idx];
+						}
 
        //                 if(year == 14 && yearDecay == 14 && i == 7 && j == 6)
 							//cout << "Satisfied Condition";
 
                         tempCost=M[yearDecay][j]+ repairCost;
                         //cout << tempCost << endl;
-                        if (tempCost <= min && tempCost!=0 && preX[yearDecay][j]!=yearDecay){//prevent multiple repairs happen in the same year
+                        if (Objective::improves(tempCost, min) && tempCost!=0 && preX[yearDecay][j]!=yearDecay){//prevent multiple repairs happen in the same year
                             //cout <<"temp cost:"<< tempCost << "year" << year <<  "rating" << rating << endl;
                             min=tempCost;
                             preX[year][rating]=yearDecay;
@@ -120,230 +230,150 @@ float findOptEnvSchedule(BridgeInfo bridge, int ratingsDecay[][10], RepairEnvMat
             //cout << "updated" << "year" << year <<  "rating" << rating << "min" << min <<endl;
         }
     }
+#ifdef COUNT_ALLOCATIONS
+	long dpAllocations = threadAllocations() - allocationsBefore;
+#endif
     
-    /* outputs the optimal schedule to a text file */
-    int x=100;
-    int y=5;
     float minTotalCost = numeric_limits<float>::infinity();
-    int optFinalCondition;
-    ofstream ofile("Optimal Maintenance Schedule");
-    for (int i = limit; i < 8; i++) {
-        x = 100;
-        y = i;
-        
-        ofile << "Final Condition:" << i << endl;
-        ofile << "Best Estimate Cost:" << M[x][i] << endl;
-        if (M[x][i] < minTotalCost) {
-            minTotalCost = M[x][i];
+    int optFinalCondition = -1;	// stays -1 if no final condition can be reached
+    for (int i = limit; i < nRatings-1; i++) {
+        if (M[nYears-1][i] < minTotalCost) {
+            minTotalCost = M[nYears-1][i];
             optFinalCondition = i;
         }
-        ofile << "     Year  RepairID" << endl;
-        
-        while (preX[x][y]>= 0){
-            ofile << setw(8) << preX[x][y];
-            ofile << setw(8) << preRepair[x][y];
-            ofile << setw(8) << preY[x][y] << endl;
-            int temp = x;
-            x=preX[x][y];
-            y=preY[temp][y];
+    }
+
+    /* outputs the optimal schedule to a text file; the solves of a sample have none */
+    int x=nYears-1;
+    int y=5;
+    if (!reportFile.empty()) {
+        ofstream ofile(reportFile.c_str());
+        for (int i = limit; i < nRatings-1; i++) {
+            x = nYears-1;
+            y = i;
+
+            ofile << "Final Condition:" << i << endl;
+            ofile << "Best Estimate Cost:" << M[x][i] << endl;
+            ofile << "     Year  RepairID" << endl;
+
+            while (preX[x][y]>= 0){
+                ofile << setw(8) << preX[x][y];
+                ofile << setw(8) << preRepair[x][y];
+                ofile << setw(8) << preY[x][y] << endl;
+                int temp = x;
+                x=preX[x][y];
+                y=preY[temp][y];
+            }
         }
+        ofile.close();
     }
-    ofile.close();
     
     /* update the optSchedule Matrix */
-    x = 100;
+    x = nYears-1;
     y = optFinalCondition;
-    cout << "The Minimum Emission/Cost is " << minTotalCost << endl;
+    // the schedule is logged in one piece so that concurrent solves don't interleave
+    ostringstream report;
+    bool printed = !reportFile.empty() && logEnabled(LogDebug);
+    if (printed)
+        report << "The Minimum Emission/Cost is " << minTotalCost << endl;
     int k = 0;
 	RepairSchedule temp;
-    while (preX[x][y]>-1 && preRepair[x][y]>0){
+    while (optFinalCondition >= 0 && preX[x][y]>-1 && preRepair[x][y]>0){
 		Pair oneRepair;
-        cout << setw(8) << preX[x][y];
 		oneRepair.repairYear = preX[x][y] + bridge.startYear;
-        cout  << setw(8) << preRepair[x][y];
         oneRepair.repairID = preRepair[x][y];
-        cout << setw(8) << preY[x][y] << endl;
+		oneRepair.value = M[x][y] - M[preX[x][y]][preY[x][y]];
+        if (printed)
+            report << setw(8) << preX[x][y] << setw(8) << preRepair[x][y] << setw(8) << preY[x][y] << endl;
 		temp.push_back(oneRepair);
         int temp = x;
         x=preX[x][y];
         y=preY[temp][y];
         k ++;
     }
-	for( int n = temp.size()-1; n >-1;n--) {
-		optSchedule.push_back(temp[n]);
+#ifdef COUNT_ALLOCATIONS
+    if (printed)
+        report << "Heap allocations in the DP: " << dpAllocations << endl;
+#endif
+    if (printed)
+        LOG_DEBUG(report.str());
+	optSchedule.insert(optSchedule.end(), temp.rbegin(), temp.rend());
+
+	/* the best schedule reaching each final condition */
+	for (int i = limit; frontier && i < nRatings-1; i++) {
+		if (M[nYears-1][i] == numeric_limits<float>::infinity())
+			continue;
+		ConditionSchedule condition;
+		condition.finalRating = i;
+		condition.minimum = M[nYears-1][i];
+		x = nYears-1;
+		y = i;
+		while (preX[x][y]>-1 && preRepair[x][y]>0) {
+			Pair oneRepair;
+			oneRepair.repairYear = preX[x][y] + bridge.startYear;
+			oneRepair.repairID = preRepair[x][y];
+			oneRepair.value = M[x][y] - M[preX[x][y]][preY[x][y]];
+			condition.schedule.insert(condition.schedule.begin(), oneRepair);
+			int temp = x;
+			x=preX[x][y];
+			y=preY[temp][y];
+		}
+		frontier->push_back(condition);
 	}
 
 	return minTotalCost;
     
 }
 
-
 /* 
- * Function: findOptCostSchedule
- * Usage: findOptCostSchedule(bridgeInfo, ratingsDecay, repairsER, costs, impMat, optSchedule);
- * -----------------------------------------------------------------------------------------------------------
- * This function generates a optimal schedule for environmental impact by using a dynamic programing algorithm.
- * Returns the minimum envImpact
+ * Implementation: findOptEnvSchedule
+ * ------------------------------------
+ *
  */
-float findOptCostSchedule(BridgeInfo bridge, int ratingsDecay[][10], RepairEnvMat repairs, CostMap costs, ImproveMat impMat, int limit, RepairSchedule &optSchedule) {
-    
-    //record the track to the target M[x][y] by memorizing its precessors
-    int preX[101][9],preY[101][9],preRepair[101][9];
-    
-    //M[x][y] is the best cost achived so far for year "x" to get rating of "y"
-    float M[101][9];
-    //Initialization of M
-    for(int i=0; i<101; i++)
-        for(int j=0; j<9;j++)
-            M[i][j]=0;
-  
-	int startRating = bridge.startRating;
-	float r = bridge.discountRate;
-
-    //boundary conditions
-    for(int rating = startRating-1; rating >limit-1; rating--) {
-        for (int year = ratingsDecay[startRating][rating+1]; year <= ratingsDecay[startRating][rating];year++){
-            for(int i = 8; i> 0; i--){
-                if (i >= rating)
-                    M[year][i] = 0;
-                else
-                    M[year][i] = numeric_limits<float>::infinity();
-                
-                preX[year][i] = -1;
-                preY[year][i] = 0;
-                preRepair[year][i] = 0;
-            }
-        }
-    }
-	
-	//cout << "\n";
-	//cout << "output1:" << calEnvImpact(bridge, 0, repairs[0].repairID, 4, repairs, impMat) << endl;
-	//cout << "output2:" <<  calEnvImpact(bridge, 0, repairs[0].repairID, 5, repairs, impMat) << endl;
-	//cout << "output3:" <<   calEnvImpact(bridge, 0, repairs[0].repairID, 6, repairs, impMat) << endl;
-
-    /* fill in the two dimension array M[x][y] is the best cost achived so far for year "x" to get rating of "y" */
-    for(int year=0;year<101; year++){
-        
-        
-        for(int rating=limit; rating<9; rating++ ){
-            // boundary condition that has been defined previously
-            if ( rating <= startRating && ratingsDecay[startRating][rating] >= year){
-
-                continue;
-
-            } else {
-
-                // initialize the minimum cost to a very large number.
-                // any number smaller than this will replace the original
-                float min= numeric_limits<float>::infinity();
-                float tempCost=0;
-                
-                for(int i=rating;i<9;i++){
-
-                    int yearDecay=year-ratingsDecay[i][rating];
-                    if(yearDecay < 0)
-						break;
+float findOptEnvSchedule(const BridgeInfo &bridge, int ratingsDecay[][10], const RepairEnvMat &repairs, const ImproveMat &impMat, const YearFactors &factors, int limit, RepairSchedule &optSchedule, const string &reportFile) {
+	RepairCostTable table = envCostTableCompiler(bridge, repairs, impMat, factors, limit);
+	return findOptSchedule<EnvObjective>(bridge, ratingsDecay, table, limit, optSchedule, reportFile);
+}
 
-                    float repairCost= numeric_limits<float>::infinity();
-                    int repairId=0;
-                    
-                    for (int j=limit;j<i;j++){
-                        for (int k=0;k<repairs.size();k++){
-							float tempRepairCost;
-		
-							// improve rating to certain level, the condition is hard-coded
-							if (i == 7 && repairs[k].improvement == 7 && (j <= repairs[k].UB && j >= repairs[k].LB)) {
-								float factor = costs[repairs[k].repairID];
-								tempRepairCost = calEnvImpact(bridge, yearDecay, repairs[k].repairID, j, repairs, impMat)*factor/pow(r+1, yearDecay);
-								if (tempRepairCost < repairCost) {
-									repairId = repairs[k].repairID;
-									repairCost = tempRepairCost;
-								}
-							} else if (repairs[k].improvement==i-j && (j <= repairs[k].UB && j >= repairs[k].LB) ) {								
-                        	    // improve rating by certain level
-								float factor = costs[repairs[k].repairID];
-                                tempRepairCost = calEnvImpact(bridge, yearDecay, repairs[k].repairID, j, repairs, impMat)*factor/pow(r+1, yearDecay);
-								if (tempRepairCost < repairCost) {
-									repairId = repairs[k].repairID;
-									repairCost = tempRepairCost;
-								}
-							} 
-                        }
-                        
-                        tempCost=M[yearDecay][j]+ repairCost;
-                        //cout << tempCost << endl;
-                        if (tempCost < min && tempCost!=0 && preX[yearDecay][j]!=yearDecay){//every year only perform one repair
-                            //cout <<"temp cost:"<< tempCost << "year" << year <<  "rating" << rating << endl;
-                            min=tempCost;
-                            preX[year][rating]=yearDecay;
-                            preY[year][rating]=j;
-                            preRepair[year][rating]=repairId;
-                        }
+float findOptEnvSchedule(const BridgeInfo &bridge, int ratingsDecay[][10], const RepairCostTable &table, int limit, RepairSchedule &optSchedule, const string &reportFile) {
+	return findOptSchedule<EnvObjective>(bridge, ratingsDecay, table, limit, optSchedule, reportFile);
+}
 
-                    }
-                }
+/* 
+ * Implementation: findOptCostSchedule
+ * ------------------------------------
+ *
+ */
+float findOptCostSchedule(const BridgeInfo &bridge, int ratingsDecay[][10], const RepairEnvMat &repairs, const CostMap &costs, const ImproveMat &impMat, const YearFactors &factors, int limit, RepairSchedule &optSchedule, const string &reportFile) {
+	RepairCostTable table = costTableCompiler(bridge, repairs, costs, impMat, factors, limit);
+	return findOptSchedule<CostObjective>(bridge, ratingsDecay, table, limit, optSchedule, reportFile);
+}
 
-				M[year][rating]=min;
+float findOptCostSchedule(const BridgeInfo &bridge, int ratingsDecay[][10], const RepairCostTable &table, int limit, RepairSchedule &optSchedule, const string &reportFile) {
+	return findOptSchedule<CostObjective>(bridge, ratingsDecay, table, limit, optSchedule, reportFile);
+}
 
-            }
-            //cout << "updated" << "year" << year <<  "rating" << rating << "min" << min <<endl;
-        }
-    }
-    
-    /* outputs the optimal schedule to a text file */
-    int x=100;
-    int y=5;
-    float minTotalCost = numeric_limits<float>::infinity();
-    int optFinalCondition;
-    ofstream ofile("Optimal Maintenance Schedule");
-    for (int i = limit; i < 8; i++) {
-        x = 100;
-        y = i;
-        
-        ofile << "Final Condition:" << i << endl;
-        ofile << "Best Estimate Cost:" << M[x][i] << endl;
-        if (M[x][i] < minTotalCost) {
-            minTotalCost = M[x][i];
-            optFinalCondition = i;
-        }
-        ofile << "     Year  RepairID" << endl;
-        
-        while (preX[x][y]>= 0){
-            ofile << setw(8) << preX[x][y];
-            ofile << setw(8) << preRepair[x][y];
-            ofile << setw(8) << preY[x][y] << endl;
-            int temp = x;
-            x=preX[x][y];
-            y=preY[temp][y];
-        }
-    }
-    ofile.close();
-    
-    /* update the optSchedule Matrix */
-    x = 100;
-    y = optFinalCondition;
-    cout << "The Minimum Emission/Cost is " << minTotalCost << endl;
-    int k = 0;
-	RepairSchedule temp;
-    while (preX[x][y]>-1 && preRepair[x][y]>0){
-		Pair oneRepair;
-        cout << setw(8) << preX[x][y];
-		oneRepair.repairYear = preX[x][y] + bridge.startYear;
-        cout  << setw(8) << preRepair[x][y];
-        oneRepair.repairID = preRepair[x][y];
-        cout << setw(8) << preY[x][y] << endl;
-		temp.push_back(oneRepair);
-        int temp = x;
-        x=preX[x][y];
-        y=preY[temp][y];
-        k ++;
-    }
-	for( int n = temp.size()-1; n >-1;n--) {
-		optSchedule.push_back(temp[n]);
-	}
+/* 
+ * Implementation: findCostFrontier
+ * ------------------------------------
+ *
+ */
+ConditionFrontier findCostFrontier(const BridgeInfo &bridge, int ratingsDecay[][10], const RepairEnvMat &repairs, const CostMap &costs, const ImproveMat &impMat, const YearFactors &factors, int limit, const string &reportFile) {
+	RepairCostTable table = costTableCompiler(bridge, repairs, costs, impMat, factors, limit);
+	RepairSchedule optSchedule;
+	ConditionFrontier frontier;
+	findOptSchedule<CostObjective>(bridge, ratingsDecay, table, limit, optSchedule, reportFile, &frontier);
+	return frontier;
+}
 
-	return minTotalCost;
-    
+/* 
+ * Implementation: findOptWeightedSchedule
+ * ------------------------------------
+ *
+ */
+float findOptWeightedSchedule(const BridgeInfo &bridge, int ratingsDecay[][10], const vector<RepairEnvMat> &repairs, const vector<float> &weights, const CostMap &costs, const ImproveMat &impMat, const YearFactors &factors, int limit, RepairSchedule &optSchedule, const string &reportFile) {
+	RepairCostTable table = weightedCostTableCompiler(bridge, repairs, weights, costs, impMat, factors, limit);
+	return findOptSchedule<WeightedObjective>(bridge, ratingsDecay, table, limit, optSchedule, reportFile);
 }
 
 /*
@@ -351,11 +381,12 @@ float findOptCostSchedule(BridgeInfo bridge, int ratingsDecay[][10], RepairEnvMa
  * ------------------------------
  *
  */
-RepairSchedule mergeFourSched(RepairSchedule vec1, RepairSchedule vec2, RepairSchedule vec3, RepairSchedule vec4) {
+RepairSchedule mergeFourSched(const RepairSchedule &vec1, const RepairSchedule &vec2, const RepairSchedule &vec3, const RepairSchedule &vec4) {
 
 	RepairSchedule result;
-	RepairSchedule::iterator itStart[4];
-	RepairSchedule::iterator itEnd[4];
+	result.reserve(vec1.size() + vec2.size() + vec3.size() + vec4.size());
+	RepairSchedule::const_iterator itStart[4];
+	RepairSchedule::const_iterator itEnd[4];
 	
 	itStart[0] = vec1.begin();
 	itStart[1] = vec2.begin();
@@ -369,8 +400,9 @@ RepairSchedule mergeFourSched(RepairSchedule vec1, RepairSchedule vec2, RepairSc
 
 	bool ends[4];
 
+	// a part without repairs is done from the start, its begin() cannot be read
 	for (int j = 0; j < 4; j ++){
-		ends[j] = false;
+		ends[j] = (itStart[j] == itEnd[j]);
 	}
 
 
@@ -401,3 +433,345 @@ RepairSchedule mergeFourSched(RepairSchedule vec1, RepairSchedule vec2, RepairSc
 	return result;
 	
 }
+
+// labels kept in one state of the Pareto DP, and schedules in a front; LCO.ice documents the cap
+static const int maxParetoLabels = 256;
+
+/*
+ * Implementation: dominates
+ * ------------------------------
+ * True if the values "a" are no worse than "b" in every objective and better in one.
+ */
+static bool dominates(const float *a, const float *b, int nObjectives) {
+	bool better = false;
+	for (int o = 0; o < nObjectives; o++) {
+		if (a[o] > b[o])
+			return false;
+		if (a[o] < b[o])
+			better = true;
+	}
+	return better;
+}
+
+struct LexicographicLess {
+	const vector<float> *values;
+	int nObjectives;
+
+	LexicographicLess(const vector<float> &values, int nObjectives) : values(&values), nObjectives(nObjectives) {}
+
+	bool operator()(int a, int b) const {
+		const float *x = &(*values)[a*nObjectives];
+		const float *y = &(*values)[b*nObjectives];
+		return lexicographical_compare(x, x + nObjectives, y, y + nObjectives);
+	}
+};
+
+/*
+ * Implementation: paretoFilter
+ * ------------------------------
+ * The non-dominated ones of "candidates", each the index of nObjectives values in "values",
+ * ordered by their first objective; of equal values the first candidate is kept. Once sorted
+ * a candidate can only be dominated by one before it, so it is compared with the kept ones only.
+ * A front larger than maxKept is thinned evenly along that order, keeping both of its ends.
+ */
+static vector<int> paretoFilter(const vector<float> &values, int nObjectives, vector<int> candidates, int maxKept) {
+	stable_sort(candidates.begin(), candidates.end(), LexicographicLess(values, nObjectives));
+	vector<int> kept;
+	for (int c = 0; c < candidates.size(); c++) {
+		const float *value = &values[candidates[c]*nObjectives];
+		bool keep = true;
+		for (int k = 0; k < kept.size() && keep; k++) {
+			const float *other = &values[kept[k]*nObjectives];
+			if (dominates(other, value, nObjectives) || equal(other, other + nObjectives, value))
+				keep = false;
+		}
+		if (keep)
+			kept.push_back(candidates[c]);
+	}
+
+	if (kept.size() > maxKept && maxKept > 1) {
+		vector<int> thinned(maxKept);
+		for (int k = 0; k < maxKept; k++)
+			thinned[k] = kept[(long)k*(kept.size()-1)/(maxKept-1)];
+		kept.swap(thinned);
+	}
+	return kept;
+}
+
+/*
+ * Implementation: paretoCostTableCompiler
+ * ------------------------------------
+ * The values are those of EnvObjective and CostObjective, so the front holds the optimum
+ * of each objective alone.
+ */
+ParetoCostTable paretoCostTableCompiler(const BridgeInfo &bridge, const vector<ParetoObjective> &objectives, const CostMap &costs, const ImproveMat &impMat, const YearFactors &factors, int limit) {
+	if (objectives.empty())
+		throw BlackBoxError("No objective to optimize");
+
+	ParetoCostTable table;
+	table.nYears = bridge.nYears;
+	table.nRatings = bridge.nRatings;
+	table.nObjectives = objectives.size();
+	int nObjectives = table.nObjectives;
+
+	// a transition is tried if every objective would try it
+	table.minGain = CostObjective::minGain;
+	for (int o = 0; o < nObjectives; o++) {
+		if (!objectives[o].cost)
+			table.minGain = EnvObjective::minGain;
+	}
+
+	const RepairEnvMat &repairs = objectives[0].repairs;
+	vector<EnvFormulaTable> formulas(nObjectives);
+	for (int o = 0; o < nObjectives; o++)
+		formulas[o] = envFormulaCompiler(bridge, objectives[o].repairs, impMat);
+	EnvObjective envObjective;
+	CostObjective costObjective(repairs, costs);
+	vector<vector<int> > buckets = repairBuckets(repairs, table.nRatings, limit);
+
+	int nTransitions = table.nYears*table.nRatings*table.nRatings;
+	table.first.assign(nTransitions + 1, 0);
+	vector<float> values;
+	vector<int> candidates;
+	for (int year = 0; year < table.nYears; year++) {
+		for (int j = 0; j < table.nRatings; j++) {
+			for (int i = 0; i < table.nRatings; i++) {
+				int idx = table.index(year, j, i);
+				table.first[idx] = table.repairID.size();
+				if (j < limit || i <= j)
+					continue;
+
+				const vector<int> &bucket = buckets[j*table.nRatings + i];
+				values.clear();
+				candidates.clear();
+				for (int b = 0; b < bucket.size(); b++) {
+					int k = bucket[b];
+					// a repair without coefficients for some objective cannot be valued
+					int repairID = repairs[k].repairID;
+					bool valued = true;
+					for (int o = 1; o < nObjectives; o++) {
+						if (repairID >= formulas[o].nRepairIDs || !formulas[o].resolved[repairID*formulas[o].nRatings + j])
+							valued = false;
+					}
+					if (!valued)
+						continue;
+
+					for (int o = 0; o < nObjectives; o++) {
+						if (objectives[o].cost)
+							values.push_back(costObjective.value(formulas[o], factors, year, k, repairs[k].repairID, j));
+						else
+							values.push_back(envObjective.value(formulas[o], factors, year, k, repairs[k].repairID, j));
+					}
+					candidates.push_back(b);
+				}
+
+				vector<int> kept = paretoFilter(values, nObjectives, candidates, candidates.size());
+				for (int c = 0; c < kept.size(); c++) {
+					table.repairID.push_back(repairs[bucket[kept[c]]].repairID);
+					table.cost.insert(table.cost.end(), values.begin() + kept[c]*nObjectives, values.begin() + (kept[c]+1)*nObjectives);
+				}
+			}
+		}
+	}
+	table.first[nTransitions] = table.repairID.size();
+
+	return table;
+}
+
+/*
+ * Implementation: findParetoSchedules
+ * ------------------------------------
+ * A label holds the totals of a path and the state, label and repair it was reached from.
+ * The transitions are those of findOptSchedule, including the repairs of the lower ratings
+ * it carries over as its running minimum; ties keep the first label instead of the last.
+ */
+ParetoFront findParetoSchedules(const BridgeInfo &bridge, int ratingsDecay[][10], const ParetoCostTable &table, int limit, const string &reportFile) {
+
+	int nYears = table.nYears;
+	int nRatings = table.nRatings;
+	int nObjectives = table.nObjectives;
+
+	// the labels of all the states; label 0 is the state before any repair
+	vector<float> totals(nObjectives, 0.0f);
+	vector<int> preX(1, -1), preY(1, 0), preLabel(1, -1), preRepair(1, 0);
+
+	//M[x][y] are the labels of the non-dominated paths to year "x" and rating "y"
+	StateGrid<vector<int> > M(nYears, nRatings, vector<int>(1, 0));
+
+	int startRating = bridge.startRating;
+
+	//boundary conditions
+	for (int rating = startRating-1; rating > limit-1; rating--) {
+		for (int year = ratingsDecay[startRating][rating+1]; year <= ratingsDecay[startRating][rating] && year < nYears; year++) {
+			for (int i = nRatings-1; i > 0; i--) {
+				if (i >= rating)
+					M[year][i] = vector<int>(1, 0);
+				else
+					M[year][i].clear();
+			}
+		}
+	}
+
+	// labels of the state being filled, before the dominated ones are dropped
+	vector<float> newTotals;
+	vector<int> newX, newY, newLabel, newRepair, candidates;
+	for (int year = 0; year < nYears; year++) {
+		for (int rating = limit; rating < nRatings; rating++) {
+			// boundary condition that has been defined previously
+			if (rating <= startRating && ratingsDecay[startRating][rating] >= year)
+				continue;
+
+			newTotals.clear();
+			newX.clear();
+			newY.clear();
+			newLabel.clear();
+			newRepair.clear();
+			for (int i = rating+table.minGain; i < nRatings; i++) {
+				int yearDecay = year-ratingsDecay[i][rating];
+				// repairs can not happen before the startYear
+				if (yearDecay < 0)
+					break;
+
+				vector<int> repairs;
+				for (int j = limit; j < i; j++) {
+					int idx = table.index(yearDecay, j, i);
+					for (int c = table.first[idx]; c < table.first[idx+1]; c++)
+						repairs.push_back(c);
+					repairs = paretoFilter(table.cost, nObjectives, repairs, repairs.size());
+
+					const vector<int> &labels = M[yearDecay][j];
+					for (int l = 0; l < labels.size(); l++) {
+						int label = labels[l];
+						//prevent multiple repairs happen in the same year
+						if (preX[label] == yearDecay)
+							continue;
+
+						for (int r = 0; r < repairs.size(); r++) {
+							int c = repairs[r];
+							bool zero = true;
+							for (int o = 0; o < nObjectives; o++) {
+								float total = totals[label*nObjectives + o] + table.cost[c*nObjectives + o];
+								newTotals.push_back(total);
+								if (total != 0)
+									zero = false;
+							}
+							if (zero) {
+								newTotals.resize(newTotals.size() - nObjectives);
+								continue;
+							}
+							newX.push_back(yearDecay);
+							newY.push_back(j);
+							newLabel.push_back(label);
+							newRepair.push_back(table.repairID[c]);
+						}
+					}
+				}
+			}
+
+			candidates.clear();
+			for (int n = 0; n < newX.size(); n++)
+				candidates.push_back(n);
+			vector<int> kept = paretoFilter(newTotals, nObjectives, candidates, maxParetoLabels);
+
+			vector<int> &labels = M[year][rating];
+			labels.clear();
+			for (int k = 0; k < kept.size(); k++) {
+				int n = kept[k];
+				labels.push_back(preX.size());
+				totals.insert(totals.end(), newTotals.begin() + n*nObjectives, newTotals.begin() + (n+1)*nObjectives);
+				preX.push_back(newX[n]);
+				preY.push_back(newY[n]);
+				preLabel.push_back(newLabel[n]);
+				preRepair.push_back(newRepair[n]);
+			}
+		}
+	}
+
+	// the front over every final condition findOptSchedule compares
+	vector<int> finals;
+	for (int i = limit; i < nRatings-1; i++)
+		finals.insert(finals.end(), M[nYears-1][i].begin(), M[nYears-1][i].end());
+	vector<int> front = paretoFilter(totals, nObjectives, finals, finals.size());
+
+	/* outputs the schedules of the front to a text file */
+	ParetoFront result;
+	ofstream ofile(reportFile.c_str());
+	for (int f = 0; f < front.size(); f++) {
+		ParetoSchedule point;
+		point.minimum.assign(totals.begin() + front[f]*nObjectives, totals.begin() + (front[f]+1)*nObjectives);
+
+		ofile << "Pareto Schedule:" << f << endl;
+		ofile << "Best Estimate Cost:";
+		for (int o = 0; o < nObjectives; o++)
+			ofile << " " << point.minimum[o];
+		ofile << endl;
+		ofile << "     Year  RepairID" << endl;
+
+		vector<ParetoRepair> temp;
+		for (int label = front[f]; preLabel[label] >= 0 && preRepair[label] > 0; label = preLabel[label]) {
+			ParetoRepair repair;
+			repair.repairID = preRepair[label];
+			repair.repairYear = preX[label] + bridge.startYear;
+			for (int o = 0; o < nObjectives; o++)
+				repair.values.push_back(totals[label*nObjectives + o] - totals[preLabel[label]*nObjectives + o]);
+			temp.push_back(repair);
+
+			ofile << setw(8) << preX[label];
+			ofile << setw(8) << preRepair[label];
+			ofile << setw(8) << preY[label] << endl;
+		}
+		point.repairs.assign(temp.rbegin(), temp.rend());
+		result.push_back(point);
+	}
+	ofile.close();
+
+	LOG_DEBUG("The Pareto front has " << result.size() << " schedules");
+	return result;
+}
+
+static bool repairsEarlier(const ParetoRepair &a, const ParetoRepair &b) {
+	return a.repairYear < b.repairYear;
+}
+
+/*
+ * Implementation: combineFronts
+ * ------------------------------
+ * Front of two components planned together; empty if either has no schedule.
+ */
+static ParetoFront combineFronts(const ParetoFront &front1, const ParetoFront &front2) {
+	ParetoFront result;
+	if (front1.empty() || front2.empty())
+		return result;
+
+	int nObjectives = front1[0].minimum.size();
+	vector<float> totals;
+	vector<int> candidates;
+	for (int a = 0; a < front1.size(); a++) {
+		for (int b = 0; b < front2.size(); b++) {
+			for (int o = 0; o < nObjectives; o++)
+				totals.push_back(front1[a].minimum[o] + front2[b].minimum[o]);
+			candidates.push_back(a*front2.size() + b);
+		}
+	}
+
+	vector<int> kept = paretoFilter(totals, nObjectives, candidates, maxParetoLabels);
+	for (int k = 0; k < kept.size(); k++) {
+		const ParetoSchedule &point1 = front1[kept[k] / front2.size()];
+		const ParetoSchedule &point2 = front2[kept[k] % front2.size()];
+		ParetoSchedule point;
+		point.minimum.assign(totals.begin() + kept[k]*nObjectives, totals.begin() + (kept[k]+1)*nObjectives);
+		point.repairs.resize(point1.repairs.size() + point2.repairs.size());
+		merge(point1.repairs.begin(), point1.repairs.end(), point2.repairs.begin(), point2.repairs.end(), point.repairs.begin(), repairsEarlier);
+		result.push_back(point);
+	}
+	return result;
+}
+
+/*
+ * Implementation: mergeFourFronts
+ * ------------------------------
+ *
+ */
+ParetoFront mergeFourFronts(const ParetoFront &front1, const ParetoFront &front2, const ParetoFront &front3, const ParetoFront &front4) {
+	return combineFronts(combineFronts(combineFronts(front1, front2), front3), front4);
+}
@@ -2,13 +2,178 @@
 #define blackBox_FindOptSchedule_h
 
 #include "Input.h"
+#include "EnvImpact.h"
+#include <limits>
 
 struct Pair{
 	int repairID;
 	int repairYear;
+	float value;	// environmental impact or cost of this repair
 };
 typedef vector<Pair> RepairSchedule;
 
+/*
+ * Struct: ConditionSchedule
+ * -------------------------
+ * The cheapest schedule of the DP that ends the plan in condition finalRating, and its total.
+ */
+struct ConditionSchedule {
+	int finalRating;
+	float minimum;
+	RepairSchedule schedule;
+};
+typedef vector<ConditionSchedule> ConditionFrontier;
+
+/*
+ * Struct: RepairCostTable
+ * -----------------------
+ * Cheapest repair for every transition of the DP, stored flat and indexed by
+ * (yearDecay, fromRating, toRating). cost holds the minimum impact/cost of lifting
+ * the condition from "fromRating" to "toRating" in year "yearDecay" and repairID the repair
+ * achieving it. Transitions that no repair can realize hold infinity and repairID 0.
+ */
+struct RepairCostTable {
+	int nYears;
+	int nRatings;
+	vector<float> cost;
+	vector<int> repairID;
+
+	int index(int year, int fromRating, int toRating) const {
+		return (year*nRatings + fromRating)*nRatings + toRating;
+	}
+};
+
+/*
+ * Struct: StateGrid
+ * -----------------
+ * Heap storage for a (year, rating) array of the DP, sized by the horizon and rating scale
+ * of the request. grid[year][rating] addresses it like the fixed arrays it replaces.
+ */
+template <typename T>
+struct StateGrid {
+	int nRatings;
+	vector<T> cells;
+
+	StateGrid(int nYears, int nRatings, T init) : nRatings(nRatings), cells(nYears*nRatings, init) {}
+
+	T* operator[](int year) {
+		return &cells[year*nRatings];
+	}
+	const T* operator[](int year) const {
+		return &cells[year*nRatings];
+	}
+};
+
+/*
+ * Struct: EnvObjective, CostObjective
+ * -----------------------------------------------------------------------------
+ * Policies of the DP kernel behind findOptEnvSchedule and findOptCostSchedule.
+ * value() is the transition cost the table compiler stores for repair k lifting "rating"
+ * in "year", from the formulas the compiler was given. minGain is the smallest rating gain of a repair the DP tries, and improves()
+ * decides whether an equal cost replaces the current minimum (true keeps the later one).
+ */
+struct EnvObjective {
+	enum { minGain = 1 };
+
+	static bool improves(float cost, float best) {
+		return cost <= best;
+	}
+	float value(const EnvFormulaTable &formulas, const YearFactors &factors, int year, int k, int repairID, int rating) const {
+		return calEnvImpact(formulas, factors, year, repairID, rating);
+	}
+};
+
+/*
+ * The environmental impact is scaled by the user's repair cost and discounted to the start year.
+ */
+struct CostObjective {
+	enum { minGain = 0 };
+
+	vector<float> repairCosts;	// the user's cost of repairs[k], 0 if none was given
+
+	CostObjective(const RepairEnvMat &repairs, const CostMap &costs);
+
+	static bool improves(float cost, float best) {
+		return cost < best;
+	}
+	float value(const EnvFormulaTable &formulas, const YearFactors &factors, int year, int k, int repairID, int rating) const {
+		return calEnvImpact(formulas, factors, year, repairID, rating)*repairCosts[k]/factors.discount[year];
+	}
+};
+
+/*
+ * The weighted sum of the objectives 1-11 given by a WeightedFormulaTable, minimized like an
+ * environmental impact. A repair that some objective with a weight has no coefficients for is not used.
+ */
+struct WeightedObjective {
+	enum { minGain = 1 };
+
+	vector<float> repairCosts;	// the user's cost of repairs[k], 0 if none was given
+
+	WeightedObjective(const RepairEnvMat &repairs, const CostMap &costs) : repairCosts(CostObjective(repairs, costs).repairCosts) {}
+
+	static bool improves(float cost, float best) {
+		return cost <= best;
+	}
+	float value(const WeightedFormulaTable &formulas, const YearFactors &factors, int year, int k, int repairID, int rating) const {
+		if (repairID >= formulas.nRepairIDs || !formulas.resolved[repairID*formulas.nRatings + rating])
+			return numeric_limits<float>::infinity();
+		return calWeightedImpact(formulas, factors, year, repairID, rating, repairCosts[k]);
+	}
+};
+
+/*
+ * Struct: ParetoObjective
+ * -----------------------
+ * One objective of a Pareto solve: the repairs with the coefficients of its optObject,
+ * and whether it is the cost objective, whose values are scaled as in CostObjective.
+ */
+struct ParetoObjective {
+	RepairEnvMat repairs;
+	bool cost;
+};
+
+/*
+ * Struct: ParetoCostTable
+ * -----------------------
+ * The non-dominated repairs of every transition of the DP, with one value per objective.
+ * The candidates of transition idx = index(yearDecay, fromRating, toRating) are first[idx]
+ * .. first[idx+1]-1; candidate c is the repair repairID[c], whose values are
+ * cost[c*nObjectives] .. cost[c*nObjectives + nObjectives-1].
+ * minGain is the smallest rating gain the DP tries, that of the objectives' policies.
+ */
+struct ParetoCostTable {
+	int nYears;
+	int nRatings;
+	int nObjectives;
+	int minGain;
+	vector<int> first;
+	vector<int> repairID;
+	vector<float> cost;
+
+	int index(int year, int fromRating, int toRating) const {
+		return (year*nRatings + fromRating)*nRatings + toRating;
+	}
+};
+
+/*
+ * Struct: ParetoSchedule
+ * ----------------------
+ * One point of a Pareto front: the total of every objective and the repairs reaching it,
+ * by year, with the value of each repair for every objective.
+ */
+struct ParetoRepair {
+	int repairID;
+	int repairYear;
+	vector<float> values;
+};
+
+struct ParetoSchedule {
+	vector<float> minimum;
+	vector<ParetoRepair> repairs;
+};
+typedef vector<ParetoSchedule> ParetoFront;
+
 /* function prototype */
 //float calCost(int yearFrom, int yearTo);
 //float findOptCostSchedule(int ratingsDecay[][10], float repairs[][4], int nRepairs, int limit, int optSchedule[][3]);
@@ -16,23 +181,80 @@ typedef vector<Pair> RepairSchedule;
 
 
 
+/*
+ * Function: envCostTableCompiler
+ * Usage: table = envCostTableCompiler(bridge, repairs, impMat, factors, limit);
+ * ----------------------------------------------------------------------------------------------------------
+ * Evaluates calEnvImpact once for every feasible (yearDecay, fromRating, toRating) transition and keeps
+ * the cheapest repair of each one, so that findOptEnvSchedule does not recompute them in its loops.
+ */
+RepairCostTable envCostTableCompiler(const BridgeInfo &bridge, const RepairEnvMat &repairs, const ImproveMat &impMat, const YearFactors &factors, int limit);
+
+/*
+ * Function: costTableCompiler
+ * Usage: table = costTableCompiler(bridge, repairs, costs, impMat, factors, limit);
+ * ----------------------------------------------------------------------------------------------------------
+ * Same as envCostTableCompiler, but the entries are the discounted repair costs used by findOptCostSchedule.
+ */
+RepairCostTable costTableCompiler(const BridgeInfo &bridge, const RepairEnvMat &repairs, const CostMap &costs, const ImproveMat &impMat, const YearFactors &factors, int limit);
+
 /* 
  * Function: findOptEnvSchedule
- * Usage: findEnvCO2Schedule(bridgeInfo, ratingsDecay, reparis, repairs, impMat, optSchedule);
+ * Usage: findEnvCO2Schedule(bridgeInfo, ratingsDecay, reparis, repairs, impMat, factors, optSchedule);
  * ----------------------------------------------------------------------------------------------------------
  * This function generates a optimal schedule for environmental impact by using a dynamic programing algorithm.
+ * The second form takes the transition costs from a table built by envCostTableCompiler.
+ * The estimates for every final condition are written to the text file "reportFile" and the
+ * schedule to the console, unless reportFile is empty.
  * Returns the minimum envImpact
  */
-float findOptEnvSchedule(BridgeInfo bridge, int ratingsDecay[][10], RepairEnvMat repairs, ImproveMat impMat, int limit, RepairSchedule &optSchedule);
+float findOptEnvSchedule(const BridgeInfo &bridge, int ratingsDecay[][10], const RepairEnvMat &repairs, const ImproveMat &impMat, const YearFactors &factors, int limit, RepairSchedule &optSchedule, const string &reportFile = "Optimal Maintenance Schedule");
+float findOptEnvSchedule(const BridgeInfo &bridge, int ratingsDecay[][10], const RepairCostTable &table, int limit, RepairSchedule &optSchedule, const string &reportFile = "Optimal Maintenance Schedule");
 
 /* 
  * Function: findOptCostSchedule
- * Usage: findOptCostSchedule(bridgeInfo, ratingsDecay,repairs, costs, impMat, optSchedule);
+ * Usage: findOptCostSchedule(bridgeInfo, ratingsDecay,repairs, costs, impMat, factors, optSchedule);
  * -----------------------------------------------------------------------------------------------------------
  * This function generates a optimal schedule for environmental impact by using a dynamic programing algorithm.
+ * The second form takes the transition costs from a table built by costTableCompiler.
+ * The estimates for every final condition are written to the text file "reportFile" and the
+ * schedule to the console, unless reportFile is empty.
  * Returns the minimum envImpact
  */
-float findOptCostSchedule(BridgeInfo bridge, int ratingsDecay[][10], RepairEnvMat repairs, CostMap costs, ImproveMat impMat, int limit, RepairSchedule &optSchedule);
+float findOptCostSchedule(const BridgeInfo &bridge, int ratingsDecay[][10], const RepairEnvMat &repairs, const CostMap &costs, const ImproveMat &impMat, const YearFactors &factors, int limit, RepairSchedule &optSchedule, const string &reportFile = "Optimal Maintenance Schedule");
+float findOptCostSchedule(const BridgeInfo &bridge, int ratingsDecay[][10], const RepairCostTable &table, int limit, RepairSchedule &optSchedule, const string &reportFile = "Optimal Maintenance Schedule");
+
+/* 
+ * Function: findCostFrontier
+ * Usage: frontier = findCostFrontier(bridgeInfo, ratingsDecay, repairs, costs, impMat, factors, limit);
+ * ----------------------------------------------------------------------------------------------------------
+ * The DP of findOptCostSchedule, returning the best schedule for every final condition it can reach
+ * instead of the cheapest one only, by increasing final condition. The report is written to "reportFile"
+ * unless it is empty.
+ */
+ConditionFrontier findCostFrontier(const BridgeInfo &bridge, int ratingsDecay[][10], const RepairEnvMat &repairs, const CostMap &costs, const ImproveMat &impMat, const YearFactors &factors, int limit, const string &reportFile = "");
+
+/*
+ * Function: weightedCostTableCompiler
+ * Usage: table = weightedCostTableCompiler(bridge, repairs, weights, costs, impMat, factors, limit);
+ * ----------------------------------------------------------------------------------------------------------
+ * Same as envCostTableCompiler, but the entries are the weighted sums of calWeightedImpact.
+ * repairs[o] and weights[o] belong to objective o+1, the cost last; the transitions are those of the
+ * repairs of the first objective with a weight.
+ */
+RepairCostTable weightedCostTableCompiler(const BridgeInfo &bridge, const vector<RepairEnvMat> &repairs, const vector<float> &weights, const CostMap &costs, const ImproveMat &impMat, const YearFactors &factors, int limit);
+
+/* 
+ * Function: findOptWeightedSchedule
+ * Usage: findOptWeightedSchedule(bridgeInfo, ratingsDecay, repairs, weights, costs, impMat, factors, limit, optSchedule);
+ * ----------------------------------------------------------------------------------------------------------
+ * This function generates a optimal schedule for a weighted sum of the environmental impacts and the cost,
+ * with the DP of findOptEnvSchedule. The weights must not be negative and one must be positive.
+ * The estimates for every final condition are written to the text file "reportFile" and the
+ * schedule to the console, unless reportFile is empty.
+ * Returns the minimum weighted sum
+ */
+float findOptWeightedSchedule(const BridgeInfo &bridge, int ratingsDecay[][10], const vector<RepairEnvMat> &repairs, const vector<float> &weights, const CostMap &costs, const ImproveMat &impMat, const YearFactors &factors, int limit, RepairSchedule &optSchedule, const string &reportFile = "Optimal Maintenance Schedule");
 
 /*
  * Function: mergeFourSched
@@ -40,5 +262,36 @@ float findOptCostSchedule(BridgeInfo bridge, int ratingsDecay[][10], RepairEnvMa
  * ----------------------------------------------------------------------------------------------------------
  * This function merge four different schedules into one, and sort the merged schedule chronologically.
  */
- RepairSchedule mergeFourSched(RepairSchedule vec1, RepairSchedule vec2, RepairSchedule vec3, RepairSchedule vec4);
+ RepairSchedule mergeFourSched(const RepairSchedule &vec1, const RepairSchedule &vec2, const RepairSchedule &vec3, const RepairSchedule &vec4);
+
+/*
+ * Function: paretoCostTableCompiler
+ * Usage: table = paretoCostTableCompiler(bridge, objectives, costs, impMat, factors, limit);
+ * ----------------------------------------------------------------------------------------------------------
+ * Evaluates every feasible transition for all the objectives at once and keeps the repairs that no
+ * other repair of the transition beats in every objective. The feasible repairs are those of
+ * objectives[0] that every other objective has coefficients for at the rating they lift.
+ */
+ParetoCostTable paretoCostTableCompiler(const BridgeInfo &bridge, const vector<ParetoObjective> &objectives, const CostMap &costs, const ImproveMat &impMat, const YearFactors &factors, int limit);
+
+/*
+ * Function: findParetoSchedules
+ * Usage: front = findParetoSchedules(bridge, ratingsDecay, table, limit);
+ * ----------------------------------------------------------------------------------------------------------
+ * The DP of findOptEnvSchedule with a set of labels, one per non-dominated vector of objective totals,
+ * in every M[year][rating] instead of a single minimum. One pass over the lattice yields the schedules
+ * of the whole front, ordered by their first objective. The front is written to the text file "reportFile".
+ * A state keeps at most 256 labels, thinned evenly over its front, so the front returned is an approximation
+ * whenever a state reached the cap: the label thinned may have been the only path to a final schedule.
+ */
+ParetoFront findParetoSchedules(const BridgeInfo &bridge, int ratingsDecay[][10], const ParetoCostTable &table, int limit, const string &reportFile = "Optimal Maintenance Schedule");
+
+/*
+ * Function: mergeFourFronts
+ * Usage: front = mergeFourFronts(front1, front2, front3, front4);
+ * ----------------------------------------------------------------------------------------------------------
+ * Front of a span from the fronts of its four sub-components: every combination of one schedule of
+ * each, kept if no other combination beats it in every objective. The repairs are merged by year.
+ */
+ParetoFront mergeFourFronts(const ParetoFront &front1, const ParetoFront &front2, const ParetoFront &front3, const ParetoFront &front4);
 #endif
\ No newline at end of file
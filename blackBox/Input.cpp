@@ -13,9 +13,29 @@
 #include <stdexcept>
 #include "PolyFit.h"
 #include "LCO.h"
+#include "Logger.h"
 
 using namespace std;
 
+// the longest plan a request may ask for, in years after startYear
+static const int maxHorizon = 200;
+
+// the repairs of SenStore, ComponentRepairOptionCrewRep01 .. ComponentRepairOptionCrewRep51
+static const int maxRepairID = 51;
+
+/*
+ * Implementation: checkRepairID
+ * ------------------------------------
+ * The catalog is indexed by repairID, so an ID outside 1 .. maxRepairID is refused before
+ * anything is sized by it.
+ */
+static void checkRepairID(int repairID, const string &source) {
+	if (repairID < 1 || repairID > maxRepairID) {
+		ostringstream reason;
+		reason << "RepairID " << repairID << " in " << source << " is not in 1-" << maxRepairID;
+		throw BlackBoxError(reason.str());
+	}
+}
 
 /*
  * Implementation: toUpper
@@ -33,9 +53,18 @@ string toUpper(string s) {
  * Calculate the years that takes for rating "x" decreasing to "y" witout maintenance
  * by using deteriorate curve obtained from polyFit.
  */
-void ratingDecay(int ratingsDecay[][10], ComponentRatingMat ratings, int limit){
-    float *coeff = polyFit(3,ratings);
-    
+void ratingDecay(int ratingsDecay[][10], const ComponentRatingMat &ratings, int limit){
+    PolyCoeffs fit = polyFit(ratings);
+    ratingDecay(ratingsDecay, fit.coeff, limit);
+}
+
+/*
+ * Implementation: ratingDecay
+ * ----------------------------------------
+ * The curve is validated before its roots are taken, so that every rating from 9 down to
+ * "limit" is crossed.
+ */
+void ratingDecay(int ratingsDecay[][10], const float coeff[], int limit){
     // coefficients of quadratic equation 
     float a = coeff[0];
     float b = coeff[1];
@@ -78,16 +107,25 @@ string ExePath() {
 }
 
 /*
- * Implementation: readRepairBasicInfo
+ * Implementation: basicInfoFile
  * ------------------------------------
  *
  */
+string basicInfoFile() {
+	return "Data\\basicInfo.txt";
+}
+
+/*
+ * Implementation: readRepairBasicInfo
+ * ------------------------------------
+ * Lines that do not hold the five fields, such as the blank ones ending the file, are skipped.
+ */
 RepairBasicInfoMat readRepairBasicInfo()
 {
     RepairBasicInfoMat repairInfoMat;
     
     ifstream infile;
-    string filename = "Data\\basicInfo.txt";
+    string filename = basicInfoFile();
 	//cout << "my directory is " << ExePath() << "\n";
     infile.open(filename.c_str());
     
@@ -97,22 +135,17 @@ RepairBasicInfoMat readRepairBasicInfo()
 		throw BlackBoxError("DataFile Not Found");
 	}
 
-	int i = 0;
-    while (infile) {
-        string line;
-        getline(infile, line);
+    string line;
+    while (getline(infile, line)) {
         istringstream stream(line);
         //cout << line << endl;
         
         RepairBasicInfo temp;
-        string type;
-        stream >> temp.repairID;
-        stream >> temp.component;
-        stream>> temp.LB >> temp.UB >> temp.improvement;
+        if (!(stream >> temp.repairID >> temp.component >> temp.LB >> temp.UB >> temp.improvement))
+            continue;
+        checkRepairID(temp.repairID, filename);
         repairInfoMat.push_back(temp);
-		i ++;
     }
-	repairInfoMat.erase(repairInfoMat.begin()+i-1);
 
     
     //cout << repairInfoMat[0].component;
@@ -126,11 +159,11 @@ RepairBasicInfoMat readRepairBasicInfo()
 
 
 /*
- * Implementation: readEnvCoef
+ * Implementation: envCoefFile
  * ------------------------------------
  *
  */
-EnvCoefMat readEnvCoef(int optObj) {
+string envCoefFile(int optObj) {
     string filename;
 	
 	switch (optObj)
@@ -169,6 +202,16 @@ EnvCoefMat readEnvCoef(int optObj) {
      filename = "Data\\ER.txt";
      break;
 }
+	return filename;
+}
+
+/*
+ * Implementation: readEnvCoef
+ * ------------------------------------
+ * Lines that do not hold the three fields, such as the tabs ending GW.txt, are skipped.
+ */
+EnvCoefMat readEnvCoef(int optObj) {
+    string filename = envCoefFile(optObj);
 	
 	EnvCoefMat envCos;
     ifstream infile;
@@ -180,20 +223,16 @@ EnvCoefMat readEnvCoef(int optObj) {
 		throw BlackBoxError("DataFile Not Found");
 	}
 
-	int i = 0;
-    while (infile) {
-        string line;
-        getline(infile, line);
+    string line;
+    while (getline(infile, line)) {
         istringstream stream(line);
         EnvCoef temp;
         
-		stream >> temp.repairID;
-        stream >> temp.repairMean;
-        stream >> temp.trafficMean;
+        if (!(stream >> temp.repairID >> temp.repairMean >> temp.trafficMean))
+            continue;
+        checkRepairID(temp.repairID, filename);
         envCos.push_back(temp);
-		i++;
     }
-    envCos.erase(envCos.begin()+i-1);
     //cout << envCos[0].repairID << envCos[0].repairMean << envCos[0].trafficMean;
     
 	infile.close();
@@ -206,7 +245,7 @@ EnvCoefMat readEnvCoef(int optObj) {
  * ------------------------------------
  *
  */
-BridgeInfo bridgeInfoCompiler(UserInput userIn, ServerInput serverIn) {
+BridgeInfo bridgeInfoCompiler(const UserInput &userIn, const ServerInput &serverIn) {
 	BridgeInfo bridge;
 	bridge.bridgeID = userIn.bridgeID;
 	bridge.bridgeWidth = serverIn.bridgeWidth;//*0.3048;			//Unit Conversion from ft to m
@@ -217,6 +256,20 @@ BridgeInfo bridgeInfoCompiler(UserInput userIn, ServerInput serverIn) {
 	bridge.startRating = userIn.startRating;
 	bridge.discountRate = userIn.discountRate;
 	bridge.trafficGrowthRate = userIn.trafficGrowthRate;
+
+	// the DP tables grow with the horizon, so a request may not ask for more than maxHorizon years;
+	// ratingsDecay covers the ratings 0-9, so the DP can use at most 10 of them
+	if (userIn.horizon < 0 || userIn.horizon > maxHorizon) {
+		ostringstream reason;
+		reason << "Horizon must be 1 to " << maxHorizon << " years, or 0 for the default";
+		throw BlackBoxError(reason.str());
+	}
+	bridge.nYears = userIn.horizon > 0 ? userIn.horizon + 1 : 101;
+	bridge.nRatings = userIn.ratingLevels > 0 ? userIn.ratingLevels : 9;
+	if (bridge.nRatings < 2 || bridge.nRatings > 10)
+		throw BlackBoxError("Rating scale must have 2 to 10 levels");
+	if (bridge.startRating < 0 || bridge.startRating >= bridge.nRatings)
+		throw BlackBoxError("The start rating must be within the rating scale");
 	
 	return bridge;
 }
@@ -226,7 +279,7 @@ BridgeInfo bridgeInfoCompiler(UserInput userIn, ServerInput serverIn) {
  * ------------------------------------
  *
  */
-RepairEnvMat envInfoCompiler(RepairInfoMat repairUserIn, string componentType, RepairBasicInfoMat &basicInfo, EnvCoefMat &envMat) {
+RepairEnvMat envInfoCompiler(const RepairInfoMat &repairUserIn, const string &componentType, const RepairBasicInfoMat &basicInfo, const EnvCoefMat &envMat) {
 	
 	RepairEnvMat repairEnv;
 	
@@ -276,12 +329,100 @@ RepairEnvMat envInfoCompiler(RepairInfoMat repairUserIn, string componentType, R
 
 } 
 
+/*
+ * Implementation: repairCatalogCompiler
+ * ------------------------------------
+ * Keeps the first row of each (repairID, component) and of each repairID in the coefficients,
+ * the rows the loops of envInfoCompiler stopped at. The tables are checked for repairIDs
+ * outside 1 .. maxRepairID before the index is sized.
+ */
+RepairCatalog repairCatalogCompiler(const RepairBasicInfoMat &basicInfo, const EnvCoefMat &envMat) {
+	RepairCatalog catalog;
+	
+	catalog.nRepairIDs = 0;
+	for(int j = 0; j < basicInfo.size(); j++) {
+		checkRepairID(basicInfo[j].repairID, "the basic info");
+		catalog.nRepairIDs = max(catalog.nRepairIDs, basicInfo[j].repairID + 1);
+		if (catalog.componentIndex.find(basicInfo[j].component) == catalog.componentIndex.end()) {
+			int c = catalog.componentIndex.size();
+			catalog.componentIndex[basicInfo[j].component] = c;
+		}
+	}
+	for(int k = 0; k < envMat.size(); k++) {
+		checkRepairID(envMat[k].repairID, "the coefficients");
+		catalog.nRepairIDs = max(catalog.nRepairIDs, envMat[k].repairID + 1);
+	}
+
+	int nComponents = catalog.componentIndex.size();
+	catalog.known.assign(catalog.nRepairIDs, 0);
+	catalog.basic.assign(catalog.nRepairIDs*nComponents, -1);
+	catalog.env.assign(catalog.nRepairIDs, -1);
+
+	for(int j = 0; j < basicInfo.size(); j++) {
+		int id = basicInfo[j].repairID;
+		catalog.known[id] = 1;
+		int idx = id*nComponents + catalog.componentIndex[basicInfo[j].component];
+		if (catalog.basic[idx] < 0)
+			catalog.basic[idx] = j;
+	}
+	for(int k = 0; k < envMat.size(); k++) {
+		int id = envMat[k].repairID;
+		if (catalog.env[id] < 0)
+			catalog.env[id] = k;
+	}
+
+	return catalog;
+}
+
+/*
+ * Implementation: envInfoCompiler
+ * ------------------------------------
+ * The join through the catalog; same results and errors as the form that scans the tables.
+ */
+RepairEnvMat envInfoCompiler(const RepairInfoMat &repairUserIn, const string &componentType, const RepairBasicInfoMat &basicInfo, const EnvCoefMat &envMat, const RepairCatalog &catalog) {
+	
+	RepairEnvMat repairEnv;
+	map<string,int>::const_iterator component = catalog.componentIndex.find(componentType);
+	int nComponents = catalog.componentIndex.size();
+	
+	for(int i = 0; i < repairUserIn.size(); i++) {
+		if( repairUserIn[i].avail == true) {
+			int id = repairUserIn[i].repairID;
+			bool inCatalog = id >= 0 && id < catalog.nRepairIDs;
+
+			if (!inCatalog || !catalog.known[id])
+				throw BlackBoxError("Repair Basic Info Not Found");
+			if (catalog.env[id] < 0)
+				throw BlackBoxError("Repair Env Coeff Not Found");
+
+			if (component == catalog.componentIndex.end())
+				continue;
+			int j = catalog.basic[id*nComponents + component->second];
+			if (j < 0)
+				continue;
+
+			const EnvCoef &coef = envMat[catalog.env[id]];
+			RepairEnv temp;
+			temp.repairID = id;
+			temp.duration = repairUserIn[i].duration;
+			temp.LB = basicInfo[j].LB;
+			temp.UB = basicInfo[j].UB;
+			temp.improvement = basicInfo[j].improvement;
+			temp.repairMean = coef.repairMean;
+			temp.trafficMean = coef.trafficMean;
+			repairEnv.push_back(temp);
+		}
+	}
+
+	return repairEnv;
+}
+
 /*
  * Implementation: readRepairCost
  * --------------------------------
  *
  */
-CostMap readRepairCost(RepairInfoMat repairUserIn){
+CostMap readRepairCost(const RepairInfoMat &repairUserIn){
 	CostMap costs;
 	for(int i = 0; i < repairUserIn.size(); i++) {
 		if( repairUserIn[i].avail == true) {	
@@ -296,7 +437,7 @@ CostMap readRepairCost(RepairInfoMat repairUserIn){
  * --------------------------------
  *
  */
-ServerInput readServerInput(int bridgeID, int componentID){
+ServerInput readServerInput(const SenStoreMngrPrx &manager, int bridgeID, int componentID){
 
 using namespace SenStore;
 int status = 0;
@@ -305,17 +446,7 @@ int status = 0;
 //char* argv[];
 ServerInput serverIn;
 
-Ice::CommunicatorPtr ic;
-char ** fakeArgV = NULL;
-int fakeArgc = 0;
 try {
-	ic = Ice::initialize(fakeArgc, fakeArgV);
-	Ice::ObjectPrx base = ic->stringToProxy("SenStore:default -h panther.eecs.umich.edu -p 10004");
-	SenStoreMngrPrx manager = SenStoreMngrPrx::checkedCast(base);
-
-	if(!manager)
-		throw "Invalid proxy";
-	
 	IdList OIDs;
 
 	BridgeDetailsFields bridgeDetails;
@@ -337,19 +468,17 @@ try {
 	//if(componentDetails.mType == StructureComponentTypeDeck)
 	//	cout << "Deck";
 
-	cout << "the bridge length is " << bridgeDetails.mBridgeLength << endl;
-	cout << "the deck width is " << bridgeDetails. mOutToOutWidth << endl;
+	LOG_DEBUG("the bridge length is " << bridgeDetails.mBridgeLength);
+	LOG_DEBUG("the deck width is " << bridgeDetails. mOutToOutWidth);
 
 } catch (const Ice::Exception& ex) {
-	std::cerr << ex << endl;
-	throw ex;
+	LOG_ERROR(ex);
+	throw;
 } catch (const char* msg) {
-	std::cerr << msg << endl;
+	LOG_ERROR(msg);
 	throw msg;
 	status = 1;
 }
-if (ic)
-ic-> destroy();
 
 return serverIn;
 }
@@ -359,7 +488,7 @@ return serverIn;
  * ----------------------------
  * 
  */
-ComponentRatingMat readRatings(int bridgeID, int componentID){
+ComponentRatingMat readRatings(const SenStoreMngrPrx &manager, int bridgeID, int componentID){
 
 	using namespace SenStore;
 
@@ -368,17 +497,7 @@ ComponentRatingMat readRatings(int bridgeID, int componentID){
 	vector<int> years;
 
 	int status = 0;
-	Ice::CommunicatorPtr ic;
-	char ** fakeArgV = NULL;
-	int fakeArgc = 0;
 	try {
-		ic = Ice::initialize(fakeArgc, fakeArgV);
-		Ice::ObjectPrx base = ic->stringToProxy("SenStore:default -h panther.eecs.umich.edu -p 10004");
-		SenStoreMngrPrx manager = SenStoreMngrPrx::checkedCast(base);
-	
-		if(!manager)
-			throw "Invalid proxy";
-		
 			StructureComponentAssessmentFields assessment;
 			StructureComponentAssessmentFieldsList allAssess;
 
@@ -404,14 +523,12 @@ ComponentRatingMat readRatings(int bridgeID, int componentID){
 			ratings.years = years;
 			
 	} catch (const Ice::Exception& ex) {
-		std::cerr << ex << endl;
-		status  = 1;
+		LOG_ERROR(ex);
+		throw;
 	} catch (const char* msg) {
-		std::cerr << msg << endl;
-		status = 1;
+		LOG_ERROR(msg);
+		throw;
 	}
-	if (ic)
-		ic-> destroy();
 
     return ratings;
 }
@@ -0,0 +1,113 @@
+#include "LatencyStats.h"
+#include <climits>
+#include <cstring>
+#include "Atomic.h"
+
+static const char *const stageNames[numLatencyStages] = { "queue", "fetch", "fit", "compile", "dp", "merge", "write", "total" };
+
+/*
+ * Implementation: LatencyStats
+ * ------------------------------
+ *
+ */
+LatencyStats::LatencyStats()
+{
+	memset((void *)_histograms, 0, sizeof(_histograms));
+}
+
+/*
+ * Implementation: bucket
+ * ------------------------------
+ * Times below 4 microseconds have a bucket each. A longer time with its highest bit h has
+ * bucket 4(h-1) plus the two bits below h.
+ */
+int LatencyStats::bucket(long micros) {
+	if (micros < 4)
+		return micros < 0 ? 0 : (int)micros;
+	int high = 2;
+	while (high < 30 && (micros >> (high + 1)) != 0)
+		high++;
+	int b = 4*(high - 1) + (int)((micros >> (high - 2)) & 3);
+	return b < numBuckets ? b : numBuckets - 1;
+}
+
+/*
+ * Implementation: bucketLimit
+ * ------------------------------
+ * The first time of the next bucket.
+ */
+long LatencyStats::bucketLimit(int bucket) {
+	if (bucket < 4)
+		return bucket + 1;
+	int high = bucket/4 + 1;
+	return (long)(5 + bucket%4) << (high - 2);
+}
+
+void LatencyStats::record(LatencyStage stage, int objective, const IceUtil::Time &elapsed) {
+	if (objective < 1 || objective >= numObjectives)
+		objective = 0;
+	Ice::Long micros64 = elapsed.toMicroSeconds();
+	long micros = micros64 > LONG_MAX ? LONG_MAX : (long)micros64;
+
+	Histogram &histogram = _histograms[stage][objective];
+	atomicIncrement(&histogram.buckets[bucket(micros)]);
+	atomicIncrement(&histogram.count);
+	atomicMaximum(&histogram.maximum, micros);
+}
+
+long LatencyStats::percentile(const Histogram &histogram, long count, double fraction) {
+	long rank = (long)(fraction*count + 0.5);
+	if (rank < 1)
+		rank = 1;
+	long seen = 0;
+	for (int b = 0; b < numBuckets; b++) {
+		seen += histogram.buckets[b];
+		if (seen >= rank)
+			return bucketLimit(b) - 1 < histogram.maximum ? bucketLimit(b) - 1 : histogram.maximum;
+	}
+	return histogram.maximum;
+}
+
+StageStatsSeq LatencyStats::stats() const {
+	StageStatsSeq stages;
+	for (int s = 0; s < numLatencyStages; s++) {
+		for (int o = 0; o < numObjectives; o++) {
+			const Histogram &histogram = _histograms[s][o];
+			long count = histogram.count;
+			if (count == 0)
+				continue;
+
+			StageStats stage;
+			stage.stage = stageNames[s];
+			stage.objective = o;
+			stage.count = count;
+			stage.p50 = percentile(histogram, count, 0.5);
+			stage.p99 = percentile(histogram, count, 0.99);
+			stage.maximum = histogram.maximum;
+			stages.push_back(stage);
+		}
+	}
+	return stages;
+}
+
+/*
+ * Implementation: StageClock
+ * ------------------------------
+ * The monotonic clock, so that a change of the system time does not show as a stage.
+ */
+StageClock::StageClock(const LatencyStatsPtr &stats, int objective) :
+	_stats(stats), _objective(objective), _start(IceUtil::Time::now(IceUtil::Time::Monotonic)), _lap(_start)
+{
+}
+
+IceUtil::Time StageClock::lap(LatencyStage stage) {
+	IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+	IceUtil::Time elapsed = now - _lap;
+	_lap = now;
+	_stats->record(stage, _objective, elapsed);
+	return elapsed;
+}
+
+void StageClock::stop(LatencyStage stage) {
+	_stats->record(stage, _objective, IceUtil::Time::now(IceUtil::Time::Monotonic) - _start);
+}
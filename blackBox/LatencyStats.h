@@ -0,0 +1,118 @@
+//
+//  LatencyStats.h
+//  blackBox
+//
+//  Wall-clock time spent in each stage of optSchedule, kept as histograms per stage and
+//  objective for BlackBoxAdmin::getStats.
+//
+
+#ifndef blackBox_LatencyStats_h
+#define blackBox_LatencyStats_h
+
+#include "LCO.h"
+#include <IceUtil/IceUtil.h>
+
+using namespace LCO;
+
+/*
+ * Enum: LatencyStage
+ * -----------------------------------------------------------------------------
+ * The stages of an optSchedule request: the wait on the request pool, the SenStore reads,
+ * the fit of the deterioration curve, the compilation of the DP inputs, the DP, the merge
+ * of the parts, the SenStore writes, and the whole request from its dispatch to its answer.
+ */
+enum LatencyStage {
+	StageQueue,
+	StageFetch,
+	StageFit,
+	StageCompile,
+	StageDP,
+	StageMerge,
+	StageWrite,
+	StageTotal,
+	numLatencyStages
+};
+
+/*
+ * Class: LatencyStats
+ * -----------------------------------------------------------------------------
+ * A histogram of times for each stage and objective (optObject 1-11, 0 for any other).
+ * The buckets split every power of two microseconds in four, so a percentile is known within
+ * a quarter of its value. record() only increments counters with atomic operations, so the
+ * request threads never wait on one another; stats() reads the counters while they change,
+ * and a histogram read during a record may be off by that one time.
+ */
+class LatencyStats : public IceUtil::Shared {
+public:
+	LatencyStats();
+
+	/*
+	 * Function: record
+	 * Usage: stats->record(StageDP, optObject, elapsed);
+	 * -----------------------------------------------------------------------------
+	 * Count one time of the stage, for the objective.
+	 */
+	void record(LatencyStage stage, int objective, const IceUtil::Time &elapsed);
+
+	/*
+	 * Function: stats
+	 * Usage: StageStatsSeq stages = stats->stats();
+	 * -----------------------------------------------------------------------------
+	 * The count, median, 99th percentile and longest time of every stage and objective that
+	 * was recorded at least once. The percentiles are the upper bounds of their buckets, but
+	 * never more than the longest time.
+	 */
+	StageStatsSeq stats() const;
+
+private:
+	enum { numObjectives = 12, numBuckets = 120 };
+
+	struct Histogram {
+		volatile long count;
+		volatile long maximum;
+		volatile long buckets[numBuckets];
+	};
+
+	static int bucket(long micros);
+	static long bucketLimit(int bucket);
+	static long percentile(const Histogram &histogram, long count, double fraction);
+
+	Histogram _histograms[numLatencyStages][numObjectives];
+};
+
+typedef IceUtil::Handle<LatencyStats> LatencyStatsPtr;
+
+/*
+ * Class: StageClock
+ * -----------------------------------------------------------------------------
+ * Times the stages of one request, which run one after the other, into a LatencyStats.
+ */
+class StageClock {
+public:
+	StageClock(const LatencyStatsPtr &stats, int objective);
+
+	/*
+	 * Function: lap
+	 * Usage: clock.lap(StageFit);
+	 * -----------------------------------------------------------------------------
+	 * Record the time since the previous lap, or since the clock was made, as a time of
+	 * the stage, and return it.
+	 */
+	IceUtil::Time lap(LatencyStage stage);
+
+	/*
+	 * Function: stop
+	 * Usage: clock.stop(StageTotal);
+	 * -----------------------------------------------------------------------------
+	 * Record the time since the clock was made as a time of the stage.
+	 */
+	void stop(LatencyStage stage);
+
+private:
+	LatencyStatsPtr _stats;
+	int _objective;
+	IceUtil::Time _start;
+	IceUtil::Time _lap;
+};
+
+#endif
@@ -0,0 +1,177 @@
+#include "Logger.h"
+#include "Atomic.h"
+#include "LCO.h"
+#include <iostream>
+
+volatile long logThreshold = LogInfo;
+
+static const char *const levelNames[] = { "debug", "info", "warning", "error", "none" };
+static const char *const levelLabels[] = { "DEBUG", "INFO", "WARNING", "ERROR", "" };
+
+// the drains of the logging thread; a message waits at most this long on the console
+static const int drainMilliseconds = 50;
+
+static LoggerPtr activeLogger;
+static IceUtil::ThreadControl activeControl;
+
+/*
+ * Implementation: writeLine
+ * ------------------------------
+ * Warnings and errors go to cerr, the other messages to cout. A message of several lines
+ * may end with its own newline. Flushed by the caller.
+ */
+static void writeLine(LogLevel level, const IceUtil::Time &time, const string &message) {
+	ostream &stream = level >= LogWarning ? cerr : cout;
+	stream << time.toDateTime() << ' ' << levelLabels[level] << ": " << message;
+	if (message.empty() || message[message.size() - 1] != '\n')
+		stream << '\n';
+}
+
+/*
+ * Implementation: logWrite
+ * ------------------------------
+ * Before startLogging and after stopLogging the message is written by the calling thread.
+ */
+void logWrite(LogLevel level, const string &message) {
+	Logger *logger = activeLogger.get();
+	if (logger) {
+		logger->push(level, message);
+		return;
+	}
+	writeLine(level, IceUtil::Time::now(), message);
+	(level >= LogWarning ? cerr : cout).flush();
+}
+
+LogLevel logLevel(const string &name) {
+	for (int l = LogDebug; l <= LogNone; l++) {
+		if (name == levelNames[l])
+			return (LogLevel)l;
+	}
+	throw LCO::BlackBoxError("Unknown log level " + name + ", expected debug, info, warning, error or none");
+}
+
+void startLogging(LogLevel threshold, int capacity) {
+	logThreshold = threshold;
+	activeLogger = new Logger(capacity, IceUtil::Time::milliSeconds(drainMilliseconds));
+	activeControl = activeLogger->start();
+}
+
+/*
+ * Implementation: stopLogging
+ * ------------------------------
+ * The thread drains the ring once more after destroy(), so no queued message is lost.
+ */
+void stopLogging() {
+	if (!activeLogger)
+		return;
+	activeLogger->destroy();
+	activeControl.join();
+	activeLogger = 0;
+}
+
+/*
+ * Implementation: Logger
+ * ------------------------------
+ * Slot i starts with sequence i: free for the writer at position i.
+ */
+Logger::Logger(int capacity, const IceUtil::Time &interval) :
+	_writePosition(0), _readPosition(0), _dropped(0), _interval(interval), _destroyed(false)
+{
+	unsigned long size = 1;
+	while (size < (unsigned long)capacity)
+		size <<= 1;
+	_slots.resize(size);
+	for (unsigned long i = 0; i < size; i++)
+		_slots[i].sequence = (long)i;
+	_mask = size - 1;
+}
+
+/*
+ * Implementation: push
+ * ------------------------------
+ * The slot at the write position is free if its sequence is the position, still holds the
+ * message of the previous lap if it is behind (the ring is full), and was taken by another
+ * writer if it is ahead. The positions are compared as unsigned differences so that they
+ * may wrap around.
+ */
+bool Logger::push(LogLevel level, const string &message) {
+	unsigned long position = (unsigned long)atomicLoad(&_writePosition);
+	Slot *slot;
+	for (;;) {
+		slot = &_slots[position & _mask];
+		long difference = (long)((unsigned long)atomicLoad(&slot->sequence) - position);
+		if (difference == 0) {
+			unsigned long seen = (unsigned long)atomicCompareAndSwap(&_writePosition, (long)position, (long)(position + 1));
+			if (seen == position)
+				break;
+			position = seen;
+		} else if (difference < 0) {
+			atomicIncrement(&_dropped);
+			return false;
+		} else {
+			position = (unsigned long)atomicLoad(&_writePosition);
+		}
+	}
+
+	slot->level = level;
+	slot->time = IceUtil::Time::now();
+	slot->message = message;
+	atomicStore(&slot->sequence, (long)(position + 1));
+	return true;
+}
+
+/*
+ * Implementation: drain
+ * ------------------------------
+ * Only the logging thread reads, so the read position is its own. A slot is ready once its
+ * writer has set its sequence to the position + 1; it is handed back to the writers of the
+ * next lap with the position + size.
+ */
+void Logger::drain() {
+	bool written = false;
+	string message;
+	for (;;) {
+		Slot &slot = _slots[_readPosition & _mask];
+		if ((long)((unsigned long)atomicLoad(&slot.sequence) - (_readPosition + 1)) < 0)
+			break;
+
+		LogLevel level = slot.level;
+		IceUtil::Time time = slot.time;
+		message.swap(slot.message);
+		atomicStore(&slot.sequence, (long)(_readPosition + _mask + 1));
+		_readPosition++;
+
+		writeLine(level, time, message);
+		written = true;
+	}
+
+	long dropped = atomicExchange(&_dropped, 0);
+	if (dropped > 0) {
+		ostringstream note;
+		note << "Log queue full, " << dropped << " messages dropped";
+		writeLine(LogWarning, IceUtil::Time::now(), note.str());
+		written = true;
+	}
+	if (written) {
+		cout.flush();
+		cerr.flush();
+	}
+}
+
+void Logger::run() {
+	IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
+	while (!_destroyed) {
+		timedWait(_interval);
+
+		lock.release();
+		drain();
+		lock.acquire();
+	}
+	drain();
+}
+
+void Logger::destroy() {
+	IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
+	_destroyed = true;
+	notify();
+}
@@ -0,0 +1,157 @@
+//
+//  Logger.h
+//  blackBox
+//
+//  Leveled messages of the server, written to the console by a thread of their own so that
+//  the threads solving requests never wait on the console.
+//
+
+#ifndef blackBox_Logger_h
+#define blackBox_Logger_h
+
+#include <IceUtil/IceUtil.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+enum LogLevel {
+	LogDebug,
+	LogInfo,
+	LogWarning,
+	LogError,
+	LogNone
+};
+
+// levels below LOG_COMPILED_LEVEL are removed by the compiler: the debug messages only
+// exist in the Debug configuration
+#ifndef LOG_COMPILED_LEVEL
+#ifdef NDEBUG
+#define LOG_COMPILED_LEVEL 1
+#else
+#define LOG_COMPILED_LEVEL 0
+#endif
+#endif
+
+extern volatile long logThreshold;
+
+/*
+ * Function: logEnabled
+ * Usage: if (logEnabled(LogDebug)) ...
+ * -----------------------------------------------------------------------------
+ * Whether messages of the level are written: the level is compiled in and reaches the
+ * threshold set by startLogging. Constant false for the levels compiled out.
+ */
+inline bool logEnabled(LogLevel level) {
+	return level >= LOG_COMPILED_LEVEL && level >= logThreshold;
+}
+
+/*
+ * Function: logWrite
+ * Usage: logWrite(LogInfo, "Server started");
+ * -----------------------------------------------------------------------------
+ * Queue a message for the logging thread, or write it at once if startLogging has not been
+ * called. Never waits: a message that finds the queue full is dropped and counted.
+ */
+void logWrite(LogLevel level, const string &message);
+
+/*
+ * Macro: LOG_DEBUG, LOG_INFO, LOG_WARNING, LOG_ERROR
+ * Usage: LOG_INFO("Reference data reloaded, version " << version);
+ * -----------------------------------------------------------------------------
+ * Log the message, a chain of values for operator<<. The message is only formatted if its
+ * level is enabled, so a disabled message costs one comparison; LOG_DEBUG is no code at
+ * all outside the Debug configuration.
+ */
+#define LOG_AT(level, message) \
+	do { \
+		if (logEnabled(level)) { \
+			std::ostringstream logMessage_; \
+			logMessage_ << message; \
+			logWrite(level, logMessage_.str()); \
+		} \
+	} while (0)
+
+#if LOG_COMPILED_LEVEL <= 0
+#define LOG_DEBUG(message) LOG_AT(LogDebug, message)
+#else
+#define LOG_DEBUG(message) ((void)0)
+#endif
+#define LOG_INFO(message) LOG_AT(LogInfo, message)
+#define LOG_WARNING(message) LOG_AT(LogWarning, message)
+#define LOG_ERROR(message) LOG_AT(LogError, message)
+
+/*
+ * Function: logLevel
+ * Usage: LogLevel level = logLevel(props->getPropertyWithDefault("BlackBox.Log.Level", "info"));
+ * -----------------------------------------------------------------------------
+ * The level named debug, info, warning, error or none. Throws BlackBoxError for any other name.
+ */
+LogLevel logLevel(const string &name);
+
+/*
+ * Function: startLogging
+ * Usage: startLogging(LogInfo, 4096);
+ * -----------------------------------------------------------------------------
+ * Write the messages of "threshold" and above from now on through a queue of "capacity"
+ * messages (rounded up to a power of two), drained by a thread started here. Called once,
+ * before the server takes requests.
+ */
+void startLogging(LogLevel threshold, int capacity);
+
+/*
+ * Function: stopLogging
+ * Usage: stopLogging();
+ * -----------------------------------------------------------------------------
+ * Write the queued messages and end the logging thread; later messages are written at once.
+ * Called once no other thread logs any more.
+ */
+void stopLogging();
+
+/*
+ * Class: Logger
+ * -----------------------------------------------------------------------------
+ * The queue of startLogging and its thread. The queue is a ring of slots, each with a
+ * sequence number telling whether it is free for a writer or ready for the thread; a writer
+ * takes a slot by advancing the write position with a compare-and-swap, so writers neither
+ * lock nor wait on one another (the bounded queue of D. Vyukov, with one reader). The thread
+ * drains the ring every "interval" and flushes the console once per drain.
+ */
+class Logger : public IceUtil::Thread, public IceUtil::Monitor<IceUtil::Mutex> {
+public:
+	Logger(int capacity, const IceUtil::Time &interval);
+
+	/*
+	 * Function: push
+	 * Usage: if (!logger->push(level, message)) ...
+	 * -----------------------------------------------------------------------------
+	 * Queue the message; false if the ring is full, the message is then counted as dropped.
+	 */
+	bool push(LogLevel level, const string &message);
+
+	virtual void run();
+	void destroy();
+
+private:
+	struct Slot {
+		volatile long sequence;
+		LogLevel level;
+		IceUtil::Time time;
+		string message;
+	};
+
+	void drain();
+
+	vector<Slot> _slots;
+	unsigned long _mask;
+	volatile long _writePosition;
+	unsigned long _readPosition;
+	volatile long _dropped;
+	IceUtil::Time _interval;
+	bool _destroyed;
+};
+
+typedef IceUtil::Handle<Logger> LoggerPtr;
+
+#endif
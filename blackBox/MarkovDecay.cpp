@@ -0,0 +1,113 @@
+#include "MarkovDecay.h"
+#include <limits>
+#include <algorithm>
+
+/*
+ * Implementation: markovModelCompiler
+ * ------------------------------
+ * The assessments are taken in the order of their years, as polyFit takes them.
+ */
+MarkovModel markovModelCompiler(const ComponentRatingMat &ratings, int nRatings)
+{
+	vector<double> years(nRatings, 0.0), drops(nRatings, 0.0);
+	double spanned = 0.0;
+	for (int k = 1; k < ratings.ratings.size(); k++) {
+		int gap = ratings.years[k] - ratings.years[k-1];
+		int from = min(max(ratings.ratings[k-1], 0), nRatings-1);
+		int to = min(max(ratings.ratings[k], 0), nRatings-1);
+		if (gap <= 0 || to > from)
+			continue;
+
+		spanned += gap;
+		double share = (double)gap/(from - to + 1);
+		for (int r = to; r <= from; r++)
+			years[r] += share;
+		for (int r = to+1; r <= from; r++)
+			drops[r] += 1;
+	}
+	if (spanned == 0)
+		throw BlackBoxError("Need more condition rating data.");
+
+	double allYears = 0.0, allDrops = 0.0;
+	for (int r = 0; r < nRatings; r++) {
+		allYears += years[r];
+		allDrops += drops[r];
+	}
+
+	MarkovModel model;
+	model.nRatings = nRatings;
+	model.stay.resize(nRatings);
+	model.transition.assign(nRatings*nRatings, 0.0f);
+	for (int r = 0; r < nRatings; r++) {
+		double rate = years[r] > 0 ? drops[r]/years[r] : allDrops/allYears;
+		model.stay[r] = r == 0 ? 1.0f : (float)(1.0 - min(rate, 1.0));
+		model.transition[r*nRatings + r] = model.stay[r];
+		if (r > 0)
+			model.transition[r*nRatings + r-1] = 1.0f - model.stay[r];
+	}
+	return model;
+}
+
+/*
+ * Implementation: markovValueIteration
+ * ------------------------------
+ * Zero probabilities are skipped in the product rather than multiplied, so that the
+ * infinite value of a failure does not turn into NaN where it cannot be reached.
+ */
+MarkovPolicy markovValueIteration(const MarkovModel &model, const RepairCostTable &table, int limit)
+{
+	int nYears = table.nYears;
+	int nRatings = table.nRatings;
+	if (model.nRatings != nRatings)
+		throw BlackBoxError("The Markov model and the cost table have different rating scales");
+	const float infinity = numeric_limits<float>::infinity();
+
+	MarkovPolicy policy;
+	policy.nYears = nYears;
+	policy.nRatings = nRatings;
+	policy.value.assign(nYears*nRatings, infinity);
+	policy.repairID.assign(nYears*nRatings, 0);
+	policy.target.resize(nYears*nRatings);
+	for (int cell = 0; cell < nYears*nRatings; cell++)
+		policy.target[cell] = cell % nRatings;
+
+	// nothing is spent after the plan, as long as the component is above the limit
+	vector<float> next(nRatings, 0.0f);
+	for (int rating = 0; rating < limit && rating < nRatings; rating++)
+		next[rating] = infinity;
+
+	vector<float> expected(nRatings), lifted(nRatings);
+	for (int year = nYears-1; year >= 0; year--) {
+		// expected[u]: what is left to spend once a component in rating u has aged a year
+		for (int u = 0; u < nRatings; u++) {
+			const float *p = &model.transition[u*nRatings];
+			float sum = 0.0f;
+			for (int v = 0; v < nRatings; v++)
+				sum += p[v] > 0 ? p[v]*next[v] : 0.0f;
+			expected[u] = sum;
+		}
+
+		float *value = &policy.value[year*nRatings];
+		for (int rating = max(limit, 0); rating < nRatings; rating++) {
+			const float *cost = &table.cost[table.index(year, rating, 0)];
+			float best = expected[rating];
+			for (int u = rating+1; u < nRatings; u++) {
+				lifted[u] = cost[u] + expected[u];
+				best = min(best, lifted[u]);
+			}
+			value[rating] = best;
+
+			// doing nothing is kept on a tie
+			if (best < expected[rating]) {
+				int u = rating+1;
+				while (lifted[u] != best)
+					u++;
+				int cell = year*nRatings + rating;
+				policy.target[cell] = u;
+				policy.repairID[cell] = table.repairID[table.index(year, rating, u)];
+			}
+		}
+		next.assign(value, value + nRatings);
+	}
+	return policy;
+}
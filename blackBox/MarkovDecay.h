@@ -0,0 +1,71 @@
+//
+//  MarkovDecay.h
+//  blackBox
+//
+//  Markov-chain deterioration estimated from a component's assessments, and the expected-cost
+//  DP (value iteration) of optScheduleMarkov over the rating states of the schedule DP.
+//
+
+#ifndef blackBox_MarkovDecay_h
+#define blackBox_MarkovDecay_h
+
+#include "FindOptSchedule.h"
+#include <vector>
+
+using namespace std;
+
+/*
+ * Struct: MarkovModel
+ * -----------------------------------------------------------------------------
+ * Yearly transition probabilities between the ratings 0 .. nRatings-1, dense and by row:
+ * transition[from*nRatings + to]. A component in rating r keeps it for the year with
+ * probability stay[r] and drops to r-1 otherwise; rating 0 is kept.
+ */
+struct MarkovModel {
+	int nRatings;
+	vector<float> stay;
+	vector<float> transition;
+};
+
+/*
+ * Struct: MarkovPolicy
+ * -----------------------------------------------------------------------------
+ * The result of the value iteration, for every (year, rating) cell year*nRatings + rating:
+ * value is the expected total of the objective from the start of that year to the end of the
+ * plan, and repairID the repair to apply then, lifting the rating to target; repairID is 0
+ * and target the rating itself when nothing is done. Cells of a rating below the limit, or
+ * from which the limit cannot be kept, have an infinite value.
+ */
+struct MarkovPolicy {
+	int nYears;
+	int nRatings;
+	vector<float> value;
+	vector<int> repairID;
+	vector<int> target;
+};
+
+/*
+ * Function: markovModelCompiler
+ * Usage: model = markovModelCompiler(ratings, nRatings);
+ * -----------------------------------------------------------------------------
+ * Estimates stay[r] from consecutive assessments: the years between two of them are shared
+ * evenly by the ratings passed through, and every rating left counts one drop, so that
+ * stay[r] = 1 - drops[r]/years[r]. A rise of the rating is a repair and is not counted.
+ * Ratings never observed take the rate of all the others. Throws BlackBoxError if fewer than
+ * two assessments span any time.
+ */
+MarkovModel markovModelCompiler(const ComponentRatingMat &ratings, int nRatings);
+
+/*
+ * Function: markovValueIteration
+ * Usage: policy = markovValueIteration(model, table, limit);
+ * -----------------------------------------------------------------------------
+ * Backward value iteration over the years of "table": in each year and rating the component may
+ * be lifted by the cheapest repair of the table and then deteriorates for the year by the model.
+ * The expected values of the next year are propagated by one dense matrix-vector product, and
+ * each rating takes the minimum of its row of repair costs plus those values, so that both
+ * steps run over contiguous arrays. Ratings below "limit" are failures the policy must avoid.
+ */
+MarkovPolicy markovValueIteration(const MarkovModel &model, const RepairCostTable &table, int limit);
+
+#endif
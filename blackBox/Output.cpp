@@ -1,26 +1,20 @@
 #include "Output.h"
+#include "Logger.h"
+
+// ComponentRepairOptionCrewRep01 .. ComponentRepairOptionCrewRep51
+static const int numComponentRepairOptions = 51;
 
 /*
  * Implementation: writeToServer
  * ------------------------------------
  *
  */
-int writeToServer(int bridgeID, int componentID, OptimizationObjective objective, double date, EnvImpactType indicator, Unit unit, float value)
+int writeToServer(const SenStoreMngrPrx &manager, int bridgeID, int componentID, OptimizationObjective objective, double date, EnvImpactType indicator, Unit unit, float value)
 {	using namespace std;
 	using namespace SenStore;
 
-	char ** fakeArgV = NULL;
-	int fakeArgc = 0;
 	int status = 0;
-	Ice::CommunicatorPtr ic;
 	try {
-		ic = Ice::initialize(fakeArgc, fakeArgV);
-		Ice::ObjectPrx base = ic->stringToProxy("SenStore:default -h panther.eecs.umich.edu -p 10004");
-		SenStoreMngrPrx manager = SenStoreMngrPrx::checkedCast(base);
-	
-		if(!manager)
-			throw "Invalid proxy";
-
 		CompEnvBurdenMatrixFields result;
 		result.id = bridgeID;
 		result.mStructureComponent = componentID;
@@ -32,14 +26,52 @@ int writeToServer(int bridgeID, int componentID, OptimizationObjective objective
 		manager->addCompEnvBurdenMatrix(result);
 
 	} catch (const Ice::Exception& ex) {
-		std::cerr << ex << endl;
+		LOG_ERROR(ex);
 		status  = 1;
 	} catch (const char* msg) {
-		std::cerr << msg << endl;
+		LOG_ERROR(msg);
 		status = 1;
 	}
-	if (ic)
-		ic-> destroy();
+
+	return status;
+}
+
+/*
+ * Implementation: writeScheduleToServer
+ * ------------------------------------
+ * repairID n is the option ComponentRepairOptionCrewRepnn.
+ */
+int writeScheduleToServer(const SenStoreMngrPrx &manager, int bridgeID, int componentID, OptimizationObjective objective, double date, const LCO::ScheduledRepairSeq &schedule)
+{	using namespace std;
+	using namespace SenStore;
+
+	CompRepairTimelineMatrixFieldsList rows;
+	for (int i = 0; i < schedule.size(); i++) {
+		if (schedule[i].repairID < 1 || schedule[i].repairID > numComponentRepairOptions) {
+			LOG_WARNING("No ComponentRepairOption for repairID " << schedule[i].repairID);
+			continue;
+		}
+
+		CompRepairTimelineMatrixFields row;
+		row.id = bridgeID;
+		row.mStructureComponent = componentID;
+		row.mOptimizationObjective = objective;
+		row.mAssessmentDate = date;
+		row.mYearOfAction = schedule[i].year;
+		row.mComponentRepairOption = (ComponentRepairOption)(schedule[i].repairID - 1);
+		row.mRepairOptimizedValue = schedule[i].value;
+		rows.push_back(row);
+	}
+	if (rows.empty())
+		return 0;
+
+	int status = 0;
+	try {
+		manager->addCompRepairTimelineMatrixList(rows);
+	} catch (const Ice::Exception& ex) {
+		LOG_ERROR(ex);
+		status  = 1;
+	}
 
 	return status;
 }
@@ -122,7 +154,7 @@ int sysDate(){
 // current date/time based on current system
    time_t now = time(0);
 
-   cout << "Number of sec since January 1,1970:" << now << endl;
+   LOG_DEBUG("Number of sec since January 1,1970:" << now);
 
    tm *ltm = localtime(&now);
    int year = 1900 + ltm->tm_year;
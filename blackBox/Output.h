@@ -2,6 +2,7 @@
 #define blackBox_Output_h
 
 #include "SenStore.h"
+#include "LCO.h"
 #include <Ice/Ice.h>
 #include <iostream>
 #include <ctime>
@@ -11,11 +12,21 @@ using namespace SenStore;
 
 /*
  * Function: writeToServer
- * Usage: writeToServer();
+ * Usage: writeToServer(manager, bridgeID, componentID, ...);
  * -----------------------------------------------------------------------------
  * Write the optimization results to the corresponding table in the data server.
+ * manager is a proxy taken from the server's SenStorePool.
  */
-int writeToServer(int bridgeID, int componentID, OptimizationObjective objective, double date, EnvImpactType indicator, Unit unit, float value);
+int writeToServer(const SenStoreMngrPrx &manager, int bridgeID, int componentID, OptimizationObjective objective, double date, EnvImpactType indicator, Unit unit, float value);
+
+/*
+ * Function: writeScheduleToServer
+ * Usage: writeScheduleToServer(manager, bridgeID, componentID, objective, date, schedule);
+ * -----------------------------------------------------------------------------
+ * Write the optimal schedule, one CompRepairTimelineMatrix row per repair, in a single call
+ * to the data server. Repairs without a ComponentRepairOption are left out.
+ */
+int writeScheduleToServer(const SenStoreMngrPrx &manager, int bridgeID, int componentID, OptimizationObjective objective, double date, const LCO::ScheduledRepairSeq &schedule);
 
 /* 
  * Function: findEnvImpactType
@@ -14,6 +14,8 @@
 #include <string>
 #include <math.h>
 #include <stdlib.h>
+#include <vector>
+#include <algorithm>
 
 using namespace std;
 using namespace LCO;
@@ -21,138 +23,105 @@ using namespace LCO;
 
 /*
  * Function: polyFit
- * Usage: polyFit(n,3) for quadratic equation.
+ * Usage: fit = polyFit(ratings);
  * -------------------------------------------
- * Find coefficients of a linear polynomial model using least-square fitting.
- * for a linear polynomial model y = Xa + err
- * the coefficients vector a that gives the min err is given by inverse(X'X) * X'* y
+ * The points are the years since the first assessment and the ratings.
  */
-float* polyFit(int k, ComponentRatingMat ratings) 
-{   float a[10];           /*  array contains coefficients */
-    float b[10][10];       /* augmented matrix */ 
-    float x[15],y[15];   /* sample points coordinates */
-    int n; /* number of sample points */
-
-    n = readData( x, y, ratings);
-    
-    /* augmented matrix used when solve the linear equation */
-    for(int i=1;i<=k;i++)
-    {
-        for(int j=1;j<=k;j++)
-            b[i][j]=f(i+j-2,n,x);
-        b[i][k+1]=fy(i-1,n,x,y);
-    }
-    
-    b[1][1]=n;
-    gaussianElimination(k, a, b);
-    //cout << endl;
-    
-    /* for quadratic equation only*/
-    float *coeff = new float[3];
-    for (int i = 3; i > 0; i--) {
-        coeff[3-i] = a[i];
-        //cout << coeff[3-i]<< endl;
+PolyCoeffs polyFit(const ComponentRatingMat &ratings)
+{
+    int n = ratings.ratings.size();
+    vector<float> x(n), y(n);
+    for (int i = 0; i < n; i++) {
+        x[i] = ratings.years[i] - ratings.years[0];
+        y[i] = ratings.ratings[i];
     }
-    return coeff;
+    return polyFit(n > 0 ? &x[0] : 0, n > 0 ? &y[0] : 0, n);
 }
 
 /*
- * Function: f
- * Usage: f( k, n);
- * ----------------
- * Gives the sum of x raised to the kth power.
- * Needed to construct th augmented matrix.
+ * Function: polyFit
+ * Usage: fit = polyFit(x, y, n);
+ * -------------------------------------------
+ * With u = (x - centre)/halfRange in [-1, 1], the normal equations of y = A*u^2 + B*u + C are
+ * built from the sums of u^0 .. u^4 and of u^0 .. u^2 times y, all taken in one pass. They are
+ * solved by Gaussian elimination with partial pivoting, and A, B, C are turned back into the
+ * coefficients of x.
  */
-float f(int k,int n,float* x)//function gives sum of x[i]
+PolyCoeffs polyFit(const float x[], const float y[], int n)
 {
-    float sum=0;
-    for(int i=0;i<n;i++)
-        sum+=pow(x[i],k);
-    return sum;
-}
+    const char *undetermined = "Need condition ratings of at least three different years.";
+    if (n < 3)
+        throw BlackBoxError(undetermined);
 
-/*
- * Function: fy
- * Usage: f( k, n);
- * ----------------
- * Gives the sum of x raised to the kth power and multiplied by y
- * Needed to construct th augmented matrix.
- */
-float fy(int k,int n, float *x, float *y) 
-{
-    float sum=0;
-    for(int i=0;i<n;i++)
-        sum+=y[i]*pow(x[i],k);
-    return sum;
-}
+    double lo = x[0], hi = x[0];
+    for (int i = 1; i < n; i++) {
+        lo = min(lo, (double)x[i]);
+        hi = max(hi, (double)x[i]);
+    }
+    double centre = (lo + hi)/2;
+    double halfRange = (hi - lo)/2;
+    if (halfRange <= 0)
+        throw BlackBoxError(undetermined);
 
+    /* power sums */
+    double su[5] = {0, 0, 0, 0, 0};
+    double suy[3] = {0, 0, 0};
+    for (int i = 0; i < n; i++) {
+        double u = (x[i] - centre)/halfRange;
+        double u2 = u*u;
+        su[0] += 1;
+        su[1] += u;
+        su[2] += u2;
+        su[3] += u2*u;
+        su[4] += u2*u2;
+        suy[0] += y[i];
+        suy[1] += u*y[i];
+        suy[2] += u2*y[i];
+    }
 
-/* 
- * Function: gaussianElimination
- * Usage: gaussianElimnation(m);
- * -----------------------------
- * Solves m unknown linear equation by using gaussian elimination.
- */
-void gaussianElimination(int m, float a[], float b[][10])
-{
-    for(int k=1;k<m;k++) 
-    {
-        for(int i=k+1;i<m+1;i++)
-        {
-            float p1;
-            if(b[k][k]!=0)
-                p1=b[i][k]/b[k][k];
-            for(int j=k;j<m+2;j++) 
-                b[i][j]=b[i][j]-b[k][j]*p1;
-        }
+    /* augmented matrix of the normal equations in C, B, A */
+    double m[3][4];
+    for (int r = 0; r < 3; r++) {
+        for (int k = 0; k < 3; k++)
+            m[r][k] = su[r+k];
+        m[r][3] = suy[r];
     }
-    a[m]=b[m][m+1]/b[m][m];
-    for(int l=m-1;l>=1;l--)   
-        a[l]=(b[l][m+1]-F(l+1,m,a,b))/b[l][l];
-    //cout<<endl<<endl;
-    //cout<<"Best fitting equation:y=";    // 4 decimal digits
-    //if(a[1]!=0)
-    //    cout<<setiosflags(ios::fixed)<< setprecision(4)<<a[1];
-    //for(int i=2;i<m+1;i++) 
-    //{
-    //    if(a[i]>0)
-    //        cout<<" + "<<setiosflags(ios::fixed)<< setprecision(4)<<a[i]<<"*X"<<"["<<i-1<<"]";
-    //    else if(a[i]<0)
-    //        cout<<setiosflags(ios::fixed)<< setprecision(4)<< a[i]<<"*X"<<"["<<i-1<<"]";
-    //}
-    
-}
 
-/*
- * Function: F
- * Usage: F(l,m,a);
- * ----------------
- * help function that help to solve linear equation
- */
-float F(int l,int m,float c[],float b[][10])
-{
-    float sum=0;
-    for(int i=l;i<=m;i++)
-        sum+=b[l-1][i]*c[i];
-    return sum; 
-}
+    for (int col = 0; col < 3; col++) {
+        int pivot = col;
+        for (int r = col+1; r < 3; r++) {
+            if (fabs(m[r][col]) > fabs(m[pivot][col]))
+                pivot = r;
+        }
+        // u is within [-1, 1], so a pivot this small relative to n means fewer than three distinct x
+        if (fabs(m[pivot][col]) <= 1e-9*n)
+            throw BlackBoxError(undetermined);
+        for (int k = col; k < 4; k++)
+            swap(m[col][k], m[pivot][k]);
 
-/*
- * Function: readData
- * Usgae: readData();
- * ------------------
- * Reads data file and returns the number of data points 
- */
-int readData(float x[], float y[], ComponentRatingMat ratings){
-    int n= 0; // number of the data points
-  
-	for(int i = 0; i < ratings.ratings.size(); i++) {
-		x[i] = ratings.years[i]-ratings.years[0];
-		y[i] = ratings.ratings[i];
-		n++;
-	}
+        for (int r = col+1; r < 3; r++) {
+            double factor = m[r][col]/m[col][col];
+            for (int k = col; k < 4; k++)
+                m[r][k] -= factor*m[col][k];
+        }
+    }
+
+    double p[3];
+    for (int r = 2; r >= 0; r--) {
+        double sum = m[r][3];
+        for (int k = r+1; k < 3; k++)
+            sum -= m[r][k]*p[k];
+        p[r] = sum/m[r][r];
+    }
 
-    return n;
+    /* A*u^2 + B*u + C with u = (x - centre)/halfRange */
+    double A = p[2], B = p[1], C = p[0];
+    double h2 = halfRange*halfRange;
+    PolyCoeffs fit;
+    fit.coeff[0] = (float)(A/h2);
+    fit.coeff[1] = (float)(B/halfRange - 2*A*centre/h2);
+    fit.coeff[2] = (float)(A*centre*centre/h2 - B*centre/halfRange + C);
+    return fit;
 }
 
 
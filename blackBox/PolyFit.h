@@ -15,51 +15,38 @@
 using namespace std;
 using namespace LCO;
 
-/* function declaration */
-
 /*
- * Function: polyFit
- * Usage: polyFit(3, ratings) for quadratic equation.
+ * Struct: PolyCoeffs
  * ----------------------------------------------------------------------------------
- * Find coefficients of a linear polynomial model using least-square fitting.
- * for a linear polynomial model y = Xa + err
- * the coefficients vector a that gives the min err is given by inverse(X'X) * X'* y
+ * Coefficients of the quadratic a*x^2 + b*x + c fitted by polyFit:
+ * coeff[0] = a, coeff[1] = b and coeff[2] = c.
  */
-float* polyFit (int, ComponentRatingMat ratings);  
+struct PolyCoeffs {
+	float coeff[3];
+};
 
-/*
- * Function: f
- * Usage: f( k, n);
- * ------------------------------------------------------
- * Gives the sum of x raised to the kth power.
- * Needed to construct th augmented matrix.
- */
-float f(int,int, float[]);  
+/* function declaration */
 
 /*
- * Function: fy
- * Usage: f( k, n);
- * ---------------------------------------------------------------
- * Gives the sum of x raised to the kth power and multiplied by y
- * Needed to construct th augmented matrix.
- */
-float fy(int ,int, float [], float []); 
-
-/* 
- * Function: gaussianElimination
- * Usage: gaussianElimnation(m);
- * ---------------------------------------------------------------
- * Solves m unknown linear equation by using gaussian elimination.
+ * Function: polyFit
+ * Usage: fit = polyFit(ratings);
+ * ----------------------------------------------------------------------------------
+ * Least-squares quadratic through the ratings of a component, against the years since
+ * its first assessment. Any number of assessments may be given. The power sums are
+ * accumulated in double precision over x centred and scaled on its range, and the normal
+ * equations are solved with partial pivoting. Nothing is shared between calls, so it
+ * may run on many threads at once. Throws BlackBoxError if fewer than three distinct
+ * years are given, which leave the quadratic undetermined.
  */
-void gaussianElimination(int,float [], float [][10]);    
+PolyCoeffs polyFit(const ComponentRatingMat &ratings);
 
 /*
- * Function: F
- * Usage: F(l,m,a);
- * ------------------------------------------------
- * help function that help to solve linear equation
+ * Function: polyFit
+ * Usage: fit = polyFit(x, y, n);
+ * ----------------------------------------------------------------------------------
+ * Same as above for the n points (x[i], y[i]).
  */
-float F(int,int,float [], float [][10]); 
+PolyCoeffs polyFit(const float x[], const float y[], int n);
 
 /*
  * Fuction: promptUserForFile
@@ -74,13 +61,4 @@ float F(int,int,float [], float [][10]);
  */
 string promptUserForFile(ifstream & infile, string prompt = "");
 
-/*
- * Function: readData
- * Usgae: readData(x, y, ratings);
- * -----------------------------------------------------------------------------------
- * Convert struct ComponentRatingMat which contains the years and corresponding ratings 
- * into two array of float  
- */
-int readData(float[], float[],ComponentRatingMat ratings);
-
 #endif
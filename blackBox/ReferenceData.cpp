@@ -0,0 +1,137 @@
+#include "ReferenceData.h"
+#include "Logger.h"
+#include <sys/stat.h>
+
+// objectives 1-11 of UserInput.optObject
+static const int numObjectives = 11;
+
+/*
+ * Implementation: ReferenceData
+ * ------------------------------
+ * Reads every data file; throws BlackBoxError as readRepairBasicInfo and readEnvCoef do.
+ */
+ReferenceData::ReferenceData(int version) : _version(version) {
+	_basicInfo = readRepairBasicInfo();
+	_envCoef.resize(numObjectives + 1);
+	_catalog.resize(numObjectives + 1);
+	for (int optObj = 1; optObj <= numObjectives; optObj++) {
+		_envCoef[optObj] = readEnvCoef(optObj);
+		_catalog[optObj] = repairCatalogCompiler(_basicInfo, _envCoef[optObj]);
+	}
+}
+
+const RepairBasicInfoMat& ReferenceData::basicInfo() const {
+	return _basicInfo;
+}
+
+const EnvCoefMat& ReferenceData::envCoef(int optObj) const {
+	if (optObj < 1 || optObj > numObjectives)
+		throw BlackBoxError("DataFile Not Found");
+	return _envCoef[optObj];
+}
+
+const RepairCatalog& ReferenceData::catalog(int optObj) const {
+	if (optObj < 1 || optObj > numObjectives)
+		throw BlackBoxError("DataFile Not Found");
+	return _catalog[optObj];
+}
+
+int ReferenceData::version() const {
+	return _version;
+}
+
+/*
+ * Implementation: ReferenceDataStore
+ * ------------------------------
+ * The first snapshot is read here, so the server does not start without its data files.
+ */
+ReferenceDataStore::ReferenceDataStore() {
+	_mtimes = modificationTimes();
+	_data = new ReferenceData(1);
+}
+
+ReferenceDataPtr ReferenceDataStore::current() {
+	IceUtil::Mutex::Lock lock(_mutex);
+	return _data;
+}
+
+void ReferenceDataStore::reload() {
+	// one reload at a time; requests keep using the current snapshot meanwhile
+	IceUtil::Mutex::Lock reloadLock(_reloadMutex);
+
+	// taken before reading, so a file changed during the read is read again next time
+	vector<time_t> mtimes = modificationTimes();
+	ReferenceDataPtr data = new ReferenceData(current()->version() + 1);
+
+	IceUtil::Mutex::Lock lock(_mutex);
+	_data = data;
+	_mtimes = mtimes;
+}
+
+bool ReferenceDataStore::reloadIfChanged() {
+	vector<time_t> mtimes = modificationTimes();
+	{
+		IceUtil::Mutex::Lock lock(_mutex);
+		if (mtimes == _mtimes)
+			return false;
+	}
+	reload();
+	return true;
+}
+
+/*
+ * Implementation: modificationTimes
+ * ------------------------------
+ * Last modification time of each data file, 0 for a file that cannot be found.
+ */
+vector<time_t> ReferenceDataStore::modificationTimes() {
+	vector<string> files;
+	files.push_back(basicInfoFile());
+	for (int optObj = 1; optObj <= numObjectives; optObj++)
+		files.push_back(envCoefFile(optObj));
+
+	vector<time_t> mtimes;
+	for (int i = 0; i < files.size(); i++) {
+		struct stat info;
+		if (stat(files[i].c_str(), &info) == 0)
+			mtimes.push_back(info.st_mtime);
+		else
+			mtimes.push_back(0);
+	}
+	return mtimes;
+}
+
+/*
+ * Implementation: ReferenceDataWatcher
+ * ------------------------------
+ *
+ */
+ReferenceDataWatcher::ReferenceDataWatcher(const ReferenceDataStorePtr &store, int interval) :
+	_store(store), _interval(IceUtil::Time::seconds(interval)), _destroyed(false)
+{
+}
+
+void ReferenceDataWatcher::run() {
+	IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
+	while (!_destroyed) {
+		timedWait(_interval);
+		if (_destroyed)
+			break;
+
+		lock.release();
+		try {
+			if (_store->reloadIfChanged())
+				LOG_INFO("Reference data reloaded, version " << _store->current()->version());
+		} catch (const BlackBoxError &ex) {
+			// keep serving the old snapshot, the files may still be being written
+			LOG_ERROR("Reference data not reloaded: " << ex.reason);
+		}
+		lock.acquire();
+	}
+}
+
+void ReferenceDataWatcher::destroy() {
+	IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
+	_destroyed = true;
+	notify();
+}
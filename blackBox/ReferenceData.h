@@ -0,0 +1,113 @@
+//
+//  ReferenceData.h
+//  blackBox
+//
+//  Repair basic info and environmental coefficients, read from the Data files once
+//  and shared by all requests.
+//
+
+#ifndef blackBox_ReferenceData_h
+#define blackBox_ReferenceData_h
+
+#include "Input.h"
+#include <IceUtil/IceUtil.h>
+#include <ctime>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/*
+ * Class: ReferenceData
+ * -----------------------------------------------------------------------------
+ * One snapshot of the Data files: the contents of basicInfo.txt and the coefficient
+ * file of every optimization objective, indexed by optObj, with a RepairCatalog of each. A snapshot is never changed
+ * after it is built, so requests read it without locking; a reload builds a new one.
+ */
+class ReferenceData : public IceUtil::Shared {
+public:
+	ReferenceData(int version);
+
+	const RepairBasicInfoMat& basicInfo() const;
+
+	/*
+	 * Function: envCoef
+	 * Usage: envCoef(optObj);
+	 * -----------------------------------------------------------------------------
+	 * Coefficients of objective optObj (1-11), as readEnvCoef(optObj) returns them.
+	 */
+	const EnvCoefMat& envCoef(int optObj) const;
+	const RepairCatalog& catalog(int optObj) const;
+
+	/*
+	 * Function: version
+	 * Usage: version();
+	 * -----------------------------------------------------------------------------
+	 * Number of the snapshot; each reload increments it.
+	 */
+	int version() const;
+
+private:
+	RepairBasicInfoMat _basicInfo;
+	vector<EnvCoefMat> _envCoef;
+	vector<RepairCatalog> _catalog;
+	int _version;
+};
+
+typedef IceUtil::Handle<ReferenceData> ReferenceDataPtr;
+
+/*
+ * Class: ReferenceDataStore
+ * -----------------------------------------------------------------------------
+ * Holds the current snapshot. current() hands out a reference to it; reload() reads
+ * the files into a new snapshot and swaps it in, so a request keeps the snapshot it
+ * started with. If reading fails the old snapshot stays in use and the error is thrown.
+ */
+class ReferenceDataStore : public IceUtil::Shared {
+public:
+	ReferenceDataStore();
+
+	ReferenceDataPtr current();
+	void reload();
+
+	/*
+	 * Function: reloadIfChanged
+	 * Usage: store->reloadIfChanged();
+	 * -----------------------------------------------------------------------------
+	 * Reload if any data file was modified since the last load. Returns true if it reloaded.
+	 */
+	bool reloadIfChanged();
+
+private:
+	vector<time_t> modificationTimes();
+
+	IceUtil::Mutex _mutex;
+	IceUtil::Mutex _reloadMutex;
+	ReferenceDataPtr _data;
+	vector<time_t> _mtimes;
+};
+
+typedef IceUtil::Handle<ReferenceDataStore> ReferenceDataStorePtr;
+
+/*
+ * Class: ReferenceDataWatcher
+ * -----------------------------------------------------------------------------
+ * Thread that checks the data files every "interval" seconds and reloads the store
+ * when one has changed. destroy() asks it to stop; join its ThreadControl afterwards.
+ */
+class ReferenceDataWatcher : public IceUtil::Thread, public IceUtil::Monitor<IceUtil::Mutex> {
+public:
+	ReferenceDataWatcher(const ReferenceDataStorePtr &store, int interval);
+
+	virtual void run();
+	void destroy();
+
+private:
+	ReferenceDataStorePtr _store;
+	IceUtil::Time _interval;
+	bool _destroyed;
+};
+
+typedef IceUtil::Handle<ReferenceDataWatcher> ReferenceDataWatcherPtr;
+
+#endif
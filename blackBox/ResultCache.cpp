@@ -0,0 +1,93 @@
+#include "ResultCache.h"
+
+bool ResultCache::ResultKey::operator<(const ResultKey &other) const {
+	if (version != other.version)
+		return version < other.version;
+	if (generation != other.generation)
+		return generation < other.generation;
+	if (userIn < other.userIn)
+		return true;
+	if (other.userIn < userIn)
+		return false;
+	return repairs < other.repairs;
+}
+
+/*
+ * Implementation: ResultCache
+ * ------------------------------
+ *
+ */
+ResultCache::ResultCache(int capacity, int ttl) :
+	_capacity(capacity > 0 ? capacity : 0), _ttl(IceUtil::Time::seconds(ttl > 0 ? ttl : 0)), _hits(0), _misses(0)
+{
+}
+
+/*
+ * Implementation: find
+ * ------------------------------
+ * A hit moves its key to the front of the use order; an expired result is dropped and counts as a miss.
+ */
+bool ResultCache::find(const UserInput &userIn, const RepairInfoMat &repairUserIn, int version, int generation, ScheduleResult &result) {
+	if (_capacity == 0)
+		return false;
+
+	ResultKey key;
+	key.userIn = userIn;
+	key.repairs = repairUserIn;
+	key.version = version;
+	key.generation = generation;
+
+	IceUtil::Mutex::Lock lock(_mutex);
+	map<ResultKey, ResultEntry>::iterator it = _entries.find(key);
+	if (it != _entries.end() && IceUtil::Time::now(IceUtil::Time::Monotonic) - it->second.stored >= _ttl) {
+		_order.erase(it->second.use);
+		_entries.erase(it);
+		it = _entries.end();
+	}
+	if (it == _entries.end()) {
+		_misses++;
+		return false;
+	}
+
+	_order.splice(_order.begin(), _order, it->second.use);
+	result = it->second.result;
+	_hits++;
+	return true;
+}
+
+void ResultCache::store(const UserInput &userIn, const RepairInfoMat &repairUserIn, int version, int generation, const ScheduleResult &result) {
+	if (_capacity == 0)
+		return;
+
+	ResultKey key;
+	key.userIn = userIn;
+	key.repairs = repairUserIn;
+	key.version = version;
+	key.generation = generation;
+
+	IceUtil::Mutex::Lock lock(_mutex);
+	map<ResultKey, ResultEntry>::iterator it = _entries.find(key);
+	if (it != _entries.end()) {
+		_order.splice(_order.begin(), _order, it->second.use);
+	} else {
+		if (_entries.size() >= _capacity) {
+			_entries.erase(_order.back());
+			_order.pop_back();
+		}
+		_order.push_front(key);
+		it = _entries.insert(make_pair(key, ResultEntry())).first;
+		it->second.use = _order.begin();
+	}
+	it->second.result = result;
+	it->second.stored = IceUtil::Time::now(IceUtil::Time::Monotonic);
+}
+
+CacheStats ResultCache::stats() {
+	IceUtil::Mutex::Lock lock(_mutex);
+	CacheStats stats;
+	stats.hits = _hits;
+	stats.misses = _misses;
+	stats.entries = _entries.size();
+	stats.capacity = _capacity;
+	return stats;
+}
@@ -0,0 +1,81 @@
+//
+//  ResultCache.h
+//  blackBox
+//
+//  Results of recent optSchedule requests, so that a request repeated by a client is
+//  answered without solving it again.
+//
+
+#ifndef blackBox_ResultCache_h
+#define blackBox_ResultCache_h
+
+#include "LCO.h"
+#include <IceUtil/IceUtil.h>
+#include <list>
+#include <map>
+
+using namespace std;
+using namespace LCO;
+
+/*
+ * Class: ResultCache
+ * -----------------------------------------------------------------------------
+ * The last "capacity" results of optSchedule, each under the whole request (UserInput and
+ * RepairInfoMat), the version of the reference data it was solved with and the generation
+ * of the ratings, as DecayCache::generation() numbers them. When it is full the result used
+ * least recently is dropped. Results older than "ttl" seconds are not returned, since the
+ * bridge details in SenStore may have changed meanwhile. A capacity of 0 turns the cache off.
+ * The cache is shared by all requests and locks on every call.
+ */
+class ResultCache : public IceUtil::Shared {
+public:
+	ResultCache(int capacity, int ttl);
+
+	/*
+	 * Function: find
+	 * Usage: if (cache->find(userIn, repairUserIn, version, generation, result)) ...
+	 * -----------------------------------------------------------------------------
+	 * Returns true and fills result if a result is kept for the request; counts a hit or a miss.
+	 */
+	bool find(const UserInput &userIn, const RepairInfoMat &repairUserIn, int version, int generation, ScheduleResult &result);
+
+	/*
+	 * Function: store
+	 * Usage: cache->store(userIn, repairUserIn, version, generation, result);
+	 * -----------------------------------------------------------------------------
+	 * Keeps the result of the request, dropping the least recently used one if the cache is full.
+	 */
+	void store(const UserInput &userIn, const RepairInfoMat &repairUserIn, int version, int generation, const ScheduleResult &result);
+
+	CacheStats stats();
+
+private:
+	struct ResultKey {
+		UserInput userIn;
+		RepairInfoMat repairs;
+		int version;
+		int generation;
+		bool operator<(const ResultKey &other) const;
+	};
+
+	// the keys from the most recently used to the least
+	typedef list<ResultKey> UseOrder;
+
+	struct ResultEntry {
+		ScheduleResult result;
+		IceUtil::Time stored;
+		UseOrder::iterator use;
+	};
+
+	IceUtil::Mutex _mutex;
+	int _capacity;
+	IceUtil::Time _ttl;
+	map<ResultKey, ResultEntry> _entries;
+	UseOrder _order;
+	Ice::Long _hits;
+	Ice::Long _misses;
+};
+
+typedef IceUtil::Handle<ResultCache> ResultCachePtr;
+
+#endif
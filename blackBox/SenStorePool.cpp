@@ -0,0 +1,81 @@
+#include "SenStorePool.h"
+#include "LCO.h"
+#include "Logger.h"
+#include <sstream>
+
+/*
+ * Implementation: SenStorePool
+ * ------------------------------
+ * The proxies are connected lazily, on their first acquire().
+ */
+SenStorePool::SenStorePool(const Ice::CommunicatorPtr &ic, const string &proxy, int size, int checkInterval) :
+	_communicator(ic), _proxy(proxy), _checkInterval(IceUtil::Time::seconds(checkInterval)), _next(0)
+{
+	if (size < 1)
+		size = 1;
+	_slots.resize(size);
+}
+
+SenStoreMngrPrx SenStorePool::acquire() {
+	int slot;
+	SenStoreMngrPrx manager;
+	bool check;
+	{
+		IceUtil::Mutex::Lock lock(_mutex);
+		slot = _next;
+		_next = (_next + 1) % _slots.size();
+		manager = _slots[slot].manager;
+		check = IceUtil::Time::now(IceUtil::Time::Monotonic) - _slots[slot].lastChecked > _checkInterval;
+	}
+
+	// the network calls are made without the lock, a slow SenStore must not block the other slots
+	if (manager && check) {
+		try {
+			manager->ice_ping();
+		} catch (const Ice::LocalException &ex) {
+			LOG_WARNING("SenStore connection " << slot << " lost: " << ex);
+			manager = 0;
+		}
+	}
+	bool reconnected = false;
+	if (!manager) {
+		manager = connect(slot);
+		reconnected = true;
+	}
+
+	if (check || reconnected) {
+		IceUtil::Mutex::Lock lock(_mutex);
+		_slots[slot].manager = manager;
+		_slots[slot].lastChecked = IceUtil::Time::now(IceUtil::Time::Monotonic);
+	}
+	return manager;
+}
+
+void SenStorePool::invalidate(const SenStoreMngrPrx &manager) {
+	IceUtil::Mutex::Lock lock(_mutex);
+	for (int i = 0; i < _slots.size(); i++) {
+		if (_slots[i].manager == manager)
+			_slots[i].manager = 0;
+	}
+}
+
+int SenStorePool::size() const {
+	return (int)_slots.size();
+}
+
+/*
+ * Implementation: connect
+ * ------------------------------
+ * Each slot has its own connection id, so Ice opens a separate connection for it. Calls are
+ * never collocated, as the SenStore stand-in served by this process only takes marshalled requests.
+ */
+SenStoreMngrPrx SenStorePool::connect(int slot) {
+	ostringstream id;
+	id << "SenStore-" << slot;
+
+	Ice::ObjectPrx base = _communicator->stringToProxy(_proxy)->ice_connectionId(id.str())->ice_collocationOptimized(false);
+	SenStoreMngrPrx manager = SenStoreMngrPrx::checkedCast(base);
+	if (!manager)
+		throw LCO::BlackBoxError("Invalid proxy");
+	return manager;
+}
@@ -0,0 +1,69 @@
+//
+//  SenStorePool.h
+//  blackBox
+//
+//  Long-lived SenStore proxies shared by all requests of the server.
+//
+
+#ifndef blackBox_SenStorePool_h
+#define blackBox_SenStorePool_h
+
+#include "SenStore.h"
+#include <Ice/Ice.h>
+#include <IceUtil/IceUtil.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace SenStore;
+
+/*
+ * Class: SenStorePool
+ * -----------------------------------------------------------------------------
+ * Keeps "size" SenStoreMngr proxies on the server's communicator, each on its own
+ * connection, and hands them out in turn so concurrent requests do not queue on one
+ * connection. A proxy that has not been used for checkInterval seconds is pinged
+ * before it is handed out; one that fails the ping is connected again with checkedCast.
+ */
+class SenStorePool : public IceUtil::Shared {
+public:
+	SenStorePool(const Ice::CommunicatorPtr &ic, const string &proxy, int size, int checkInterval);
+
+	/*
+	 * Function: acquire
+	 * Usage: SenStoreMngrPrx manager = pool->acquire();
+	 * -----------------------------------------------------------------------------
+	 * Return a proxy that answered recently. Throws BlackBoxError if SenStore
+	 * cannot be reached; Ice errors of the reconnect are passed on.
+	 */
+	SenStoreMngrPrx acquire();
+
+	/*
+	 * Function: invalidate
+	 * Usage: pool->invalidate(manager);
+	 * -----------------------------------------------------------------------------
+	 * Mark a proxy whose call failed, so it is reconnected before it is used again.
+	 */
+	void invalidate(const SenStoreMngrPrx &manager);
+
+	int size() const;
+
+private:
+	struct Slot {
+		SenStoreMngrPrx manager;
+		IceUtil::Time lastChecked;
+	};
+
+	SenStoreMngrPrx connect(int slot);
+
+	IceUtil::Mutex _mutex;
+	Ice::CommunicatorPtr _communicator;
+	string _proxy;
+	IceUtil::Time _checkInterval;
+	vector<Slot> _slots;
+	int _next;
+};
+
+typedef IceUtil::Handle<SenStorePool> SenStorePoolPtr;
+
+#endif
@@ -0,0 +1,241 @@
+#include "SenStoreStandIn.h"
+#include "LCO.h"
+#include <fstream>
+#include <sstream>
+
+using namespace SenStore;
+
+static const char *const mngrTypeId = "::SenStore::SenStoreMngr";
+static const char *const objectTypeId = "::Ice::Object";
+
+/*
+ * Implementation: fixtureLines
+ * ------------------------------
+ * The records of a fixture file, without the empty lines and the comments.
+ */
+static vector<string> fixtureLines(const string &filename) {
+	ifstream infile(filename.c_str());
+	if (!infile.is_open())
+		throw LCO::BlackBoxError("Fixture file not found: " + filename);
+
+	vector<string> lines;
+	string line;
+	while (getline(infile, line)) {
+		string::size_type start = line.find_first_not_of(" \t\r");
+		if (start == string::npos || line[start] == '#')
+			continue;
+		lines.push_back(line);
+	}
+	return lines;
+}
+
+static void badLine(const string &filename, const string &line) {
+	throw LCO::BlackBoxError("Bad line in " + filename + ": " + line);
+}
+
+static StructureComponentType componentType(const string &name) {
+	static const char *const names[] = { "Deck", "Abutment", "PinHanger", "Span", "Column" };
+	static const StructureComponentType types[] = { StructureComponentTypeDeck, StructureComponentTypeAbutment,
+		StructureComponentTypePinHanger, StructureComponentTypeSpan, StructureComponentTypeColumn };
+	for (int i = 0; i < sizeof(names)/sizeof(names[0]); i++) {
+		if (name == names[i])
+			return types[i];
+	}
+	throw LCO::BlackBoxError("Unknown component type " + name);
+}
+
+/*
+ * Implementation: SenStoreStandInI
+ * ------------------------------
+ * The fields the fixtures do not give are left 0.
+ */
+SenStoreStandInI::SenStoreStandInI(const string &directory) : _nextID(1), _written(0)
+{
+	string prefix = directory.empty() ? "" : directory + "\\";
+	loadBridges(prefix + "bridges.txt");
+	loadComponents(prefix + "components.txt");
+	loadAssessments(prefix + "assessments.txt");
+}
+
+void SenStoreStandInI::loadBridges(const string &filename) {
+	vector<string> lines = fixtureLines(filename);
+	for (int i = 0; i < lines.size(); i++) {
+		istringstream stream(lines[i]);
+		BridgeDetailsFields bridge = BridgeDetailsFields();
+		if (!(stream >> bridge.id >> bridge.mBridgeLength >> bridge.mOutToOutWidth))
+			badLine(filename, lines[i]);
+		bridge.mStructure = bridge.id;
+		_bridges[bridge.id] = bridge;
+	}
+}
+
+void SenStoreStandInI::loadComponents(const string &filename) {
+	vector<string> lines = fixtureLines(filename);
+	for (int i = 0; i < lines.size(); i++) {
+		istringstream stream(lines[i]);
+		StructureComponentFields component = StructureComponentFields();
+		string type;
+		if (!(stream >> component.id >> component.mStructure >> type))
+			badLine(filename, lines[i]);
+		component.mType = componentType(type);
+		_components[component.id] = component;
+	}
+}
+
+/*
+ * Implementation: loadAssessments
+ * ------------------------------
+ * The assessments are numbered from 1 in the order of the file.
+ */
+void SenStoreStandInI::loadAssessments(const string &filename) {
+	vector<string> lines = fixtureLines(filename);
+	for (int i = 0; i < lines.size(); i++) {
+		istringstream stream(lines[i]);
+		StructureComponentAssessmentFields assessment = StructureComponentAssessmentFields();
+		if (!(stream >> assessment.mBridgeInspection >> assessment.mComponent >> assessment.mAssessmentDate >> assessment.mRating))
+			badLine(filename, lines[i]);
+		assessment.id = i + 1;
+		_assessments.push_back(assessment);
+	}
+}
+
+/*
+ * Implementation: findAssessments
+ * ------------------------------
+ * Only the fields readRatings compares are known; an empty list, which compares every
+ * field in SenStore, is refused with the other names.
+ */
+IdList SenStoreStandInI::findAssessments(const StructureComponentAssessmentFields &fields, const FieldNameList &names) const {
+	bool component = false;
+	bool inspection = false;
+	for (int i = 0; i < names.size(); i++) {
+		if (names[i] == "Component")
+			component = true;
+		else if (names[i] == "BridgeInspection")
+			inspection = true;
+		else {
+			ServerError ex;
+			ex.reason = "Field " + names[i] + " is not compared by the SenStore stand-in";
+			throw ex;
+		}
+	}
+	if (names.empty()) {
+		ServerError ex;
+		ex.reason = "The SenStore stand-in compares named fields only";
+		throw ex;
+	}
+
+	IdList ids;
+	for (int i = 0; i < _assessments.size(); i++) {
+		if (component && _assessments[i].mComponent != fields.mComponent)
+			continue;
+		if (inspection && _assessments[i].mBridgeInspection != fields.mBridgeInspection)
+			continue;
+		ids.push_back(_assessments[i].id);
+	}
+	return ids;
+}
+
+/*
+ * Implementation: addRows
+ * ------------------------------
+ * Returns the ID of the first of "rows" new rows; the others follow it.
+ */
+Ice::Long SenStoreStandInI::addRows(int rows) {
+	IceUtil::Mutex::Lock lock(_mutex);
+	Ice::Long first = _nextID;
+	_nextID += rows;
+	_written += rows;
+	return first;
+}
+
+long SenStoreStandInI::written() {
+	IceUtil::Mutex::Lock lock(_mutex);
+	return _written;
+}
+
+/*
+ * Implementation: ice_invoke
+ * ------------------------------
+ * The parameters are read and the results written as the generated SenStoreMngr code does.
+ * A ServerError is written as the user exception of the operation; the operations of
+ * Ice::Object are answered for checkedCast and ice_ping.
+ */
+bool SenStoreStandInI::ice_invoke(const vector<Ice::Byte> &inParams, vector<Ice::Byte> &outParams, const Ice::Current &current) {
+	Ice::CommunicatorPtr ic = current.adapter->getCommunicator();
+	Ice::InputStreamPtr in = Ice::createInputStream(ic, inParams);
+	Ice::OutputStreamPtr out = Ice::createOutputStream(ic);
+	const string &operation = current.operation;
+
+	try {
+		if (operation == "ice_ping") {
+		} else if (operation == "ice_isA") {
+			string id = in->readString();
+			out->writeBool(id == mngrTypeId || id == objectTypeId);
+		} else if (operation == "ice_id") {
+			out->writeString(mngrTypeId);
+		} else if (operation == "ice_ids") {
+			vector<string> ids;
+			ids.push_back(objectTypeId);
+			ids.push_back(mngrTypeId);
+			out->writeStringSeq(ids);
+		} else if (operation == "getBridgeDetailsFields") {
+			Ice::Long id = in->readLong();
+			map<Ice::Long, BridgeDetailsFields>::const_iterator it = _bridges.find(id);
+			if (it == _bridges.end()) {
+				ObjectDoesNotExistError ex;
+				ex.reason = "No BridgeDetails in the fixtures";
+				throw ex;
+			}
+			ice_writeBridgeDetailsFields(out, it->second);
+		} else if (operation == "getStructureComponentFields") {
+			Ice::Long id = in->readLong();
+			map<Ice::Long, StructureComponentFields>::const_iterator it = _components.find(id);
+			if (it == _components.end()) {
+				ObjectDoesNotExistError ex;
+				ex.reason = "No StructureComponent in the fixtures";
+				throw ex;
+			}
+			ice_writeStructureComponentFields(out, it->second);
+		} else if (operation == "findEqualStructureComponentAssessment") {
+			StructureComponentAssessmentFields fields;
+			ice_readStructureComponentAssessmentFields(in, fields);
+			FieldNameList names = in->readStringSeq();
+			out->writeLongSeq(findAssessments(fields, names));
+		} else if (operation == "getStructureComponentAssessmentFieldsList") {
+			IdList ids = in->readLongSeq();
+			StructureComponentAssessmentFieldsList assessments;
+			for (int i = 0; i < ids.size(); i++) {
+				if (ids[i] < 1 || ids[i] > (Ice::Long)_assessments.size()) {
+					ObjectDoesNotExistError ex;
+					ex.reason = "No StructureComponentAssessment in the fixtures";
+					throw ex;
+				}
+				assessments.push_back(_assessments[(size_t)ids[i] - 1]);
+			}
+			ice_writeStructureComponentAssessmentFieldsList(out, assessments);
+		} else if (operation == "addCompEnvBurdenMatrix") {
+			CompEnvBurdenMatrixFields fields;
+			ice_readCompEnvBurdenMatrixFields(in, fields);
+			out->writeLong(addRows(1));
+		} else if (operation == "addCompRepairTimelineMatrixList") {
+			CompRepairTimelineMatrixFieldsList rows;
+			ice_readCompRepairTimelineMatrixFieldsList(in, rows);
+			Ice::Long first = addRows((int)rows.size());
+			IdList ids;
+			for (int i = 0; i < rows.size(); i++)
+				ids.push_back(first + i);
+			out->writeLongSeq(ids);
+		} else {
+			throw Ice::OperationNotExistException(__FILE__, __LINE__, current.id, current.facet, current.operation);
+		}
+	} catch (const ServerError &ex) {
+		out = Ice::createOutputStream(ic);
+		out->writeException(ex);
+		out->finished(outParams);
+		return false;
+	}
+
+	out->finished(outParams);
+	return true;
+}
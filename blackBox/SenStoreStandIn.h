@@ -0,0 +1,75 @@
+//
+//  SenStoreStandIn.h
+//  blackBox
+//
+//  A stand-in for SenStore answering the SenStoreMngr operations the black box calls from
+//  fixture files, for load tests and for runs without the SenStore server.
+//
+
+#ifndef blackBox_SenStoreStandIn_h
+#define blackBox_SenStoreStandIn_h
+
+#include "SenStore.h"
+#include <Ice/Ice.h>
+#include <IceUtil/IceUtil.h>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/*
+ * Class: SenStoreStandInI
+ * -----------------------------------------------------------------------------
+ * Servant of the SenStoreMngr operations readServerInput, readRatings, writeToServer and
+ * writeScheduleToServer use: getBridgeDetailsFields, getStructureComponentFields,
+ * findEqualStructureComponentAssessment, getStructureComponentAssessmentFieldsList,
+ * addCompEnvBurdenMatrix and addCompRepairTimelineMatrixList. Any other operation fails
+ * with OperationNotExistException. SenStoreMngr has too many operations to implement, so
+ * the servant is a Blobject that unmarshals the requests it knows; a proxy to it must not be
+ * collocation optimized.
+ *
+ * The data are read once from the fixture files of "directory", one record per line with
+ * the fields separated by blanks; lines that are empty or start with '#' are skipped.
+ *
+ *     bridges.txt       bridgeID length width
+ *     components.txt    componentID bridgeID type (Deck, Abutment, PinHanger, Span, Column)
+ *     assessments.txt   bridgeID componentID date(yyyymmdd) rating
+ *
+ * An assessment is found by readRatings under its bridgeID, as the BridgeInspection field.
+ * Written results are numbered and counted, not kept.
+ */
+class SenStoreStandInI : public Ice::Blobject {
+public:
+	SenStoreStandInI(const string &directory);
+
+	virtual bool ice_invoke(const vector<Ice::Byte> &inParams, vector<Ice::Byte> &outParams, const Ice::Current &current);
+
+	/*
+	 * Function: written
+	 * Usage: rows = standIn->written();
+	 * -----------------------------------------------------------------------------
+	 * Number of the rows added so far by addCompEnvBurdenMatrix and addCompRepairTimelineMatrixList.
+	 */
+	long written();
+
+private:
+	void loadBridges(const string &filename);
+	void loadComponents(const string &filename);
+	void loadAssessments(const string &filename);
+
+	SenStore::IdList findAssessments(const SenStore::StructureComponentAssessmentFields &fields, const SenStore::FieldNameList &names) const;
+	Ice::Long addRows(int rows);
+
+	map<Ice::Long, SenStore::BridgeDetailsFields> _bridges;
+	map<Ice::Long, SenStore::StructureComponentFields> _components;
+	SenStore::StructureComponentAssessmentFieldsList _assessments;
+
+	IceUtil::Mutex _mutex;
+	Ice::Long _nextID;
+	long _written;
+};
+
+typedef IceUtil::Handle<SenStoreStandInI> SenStoreStandInIPtr;
+
+#endif
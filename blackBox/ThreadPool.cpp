@@ -0,0 +1,126 @@
+#include "ThreadPool.h"
+
+/*
+ * Implementation: Task
+ * ------------------------------
+ *
+ */
+Task::Task() : _finished(false) {
+}
+
+Task::~Task() {
+}
+
+void Task::execute() {
+	try {
+		run();
+	} catch (...) {
+		// run() is expected to keep its own errors; never let one kill a worker
+	}
+
+	IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
+	_finished = true;
+	notifyAll();
+}
+
+void Task::wait() {
+	IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
+	while (!_finished)
+		IceUtil::Monitor<IceUtil::Mutex>::wait();
+}
+
+bool Task::finished() {
+	IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
+	return _finished;
+}
+
+/*
+ * Implementation: ThreadPool
+ * ------------------------------
+ *
+ */
+ThreadPool::ThreadPool(int size, int maxQueued) : _maxQueued(maxQueued), _destroyed(false) {
+	if (size < 1)
+		size = 1;
+
+	for (int i = 0; i < size; i++) {
+		IceUtil::ThreadPtr worker = new Worker(this);
+		_workers.push_back(worker->start());
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	destroy();
+}
+
+bool ThreadPool::submit(const TaskPtr &task) {
+	IceUtil::Monitor<IceUtil::Mutex>::Lock lock(_monitor);
+	if (_destroyed)
+		return false;
+	if (_maxQueued > 0 && (int)_queue.size() >= _maxQueued)
+		return false;
+
+	_queue.push_back(task);
+	_monitor.notify();
+	return true;
+}
+
+bool ThreadPool::submitAdmitted(const TaskPtr &task) {
+	IceUtil::Monitor<IceUtil::Mutex>::Lock lock(_monitor);
+	if (_destroyed)
+		return false;
+
+	_queue.push_back(task);
+	_monitor.notify();
+	return true;
+}
+
+void ThreadPool::destroy() {
+	{
+		IceUtil::Monitor<IceUtil::Mutex>::Lock lock(_monitor);
+		if (_destroyed)
+			return;
+		_destroyed = true;
+		_monitor.notifyAll();
+	}
+
+	for (int i = 0; i < _workers.size(); i++)
+		_workers[i].join();
+	_workers.clear();
+}
+
+int ThreadPool::size() const {
+	return (int)_workers.size();
+}
+
+int ThreadPool::queued() {
+	IceUtil::Monitor<IceUtil::Mutex>::Lock lock(_monitor);
+	return (int)_queue.size();
+}
+
+/*
+ * Implementation: nextTask
+ * ------------------------------
+ * Blocks until a task is queued; returns a null handle once the pool is destroyed and drained.
+ */
+TaskPtr ThreadPool::nextTask() {
+	IceUtil::Monitor<IceUtil::Mutex>::Lock lock(_monitor);
+	while (_queue.empty() && !_destroyed)
+		_monitor.wait();
+
+	if (_queue.empty())
+		return 0;
+
+	TaskPtr task = _queue.front();
+	_queue.pop_front();
+	return task;
+}
+
+ThreadPool::Worker::Worker(ThreadPool *pool) : _pool(pool) {
+}
+
+void ThreadPool::Worker::run() {
+	TaskPtr task;
+	while ((task = _pool->nextTask()))
+		task->execute();
+}
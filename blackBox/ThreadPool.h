@@ -0,0 +1,80 @@
+//
+//  ThreadPool.h
+//  blackBox
+//
+//  Fixed-size pool of worker threads used to run independent DP solves concurrently.
+//
+
+#ifndef blackBox_ThreadPool_h
+#define blackBox_ThreadPool_h
+
+#include <IceUtil/IceUtil.h>
+#include <list>
+#include <vector>
+
+/*
+ * Class: Task
+ * -----------------------------------------------------------------------------
+ * A unit of work run by a ThreadPool. Subclasses implement run(); exceptions must
+ * be caught inside run() and kept in the task, the pool only reports that it finished.
+ * wait() blocks the caller until the task has been executed.
+ */
+class Task : public IceUtil::Shared, public IceUtil::Monitor<IceUtil::Mutex> {
+public:
+	Task();
+	virtual ~Task();
+
+	virtual void run() = 0;
+
+	void execute();
+	void wait();
+	bool finished();
+
+private:
+	bool _finished;
+};
+
+typedef IceUtil::Handle<Task> TaskPtr;
+
+/*
+ * Class: ThreadPool
+ * -----------------------------------------------------------------------------
+ * Runs submitted tasks on "size" worker threads in FIFO order.
+ * If maxQueued is positive, submit() refuses new tasks once that many are waiting,
+ * so callers can push back instead of queueing without bound. submitAdmitted() skips
+ * that check, for the further tasks of a request that submit() already admitted.
+ * destroy() lets the workers finish the queued tasks and joins them.
+ */
+class ThreadPool : public IceUtil::Shared {
+public:
+	ThreadPool(int size, int maxQueued = 0);
+	virtual ~ThreadPool();
+
+	bool submit(const TaskPtr &task);
+	bool submitAdmitted(const TaskPtr &task);
+	void destroy();
+
+	int size() const;
+	int queued();
+
+private:
+	class Worker : public IceUtil::Thread {
+	public:
+		Worker(ThreadPool *pool);
+		virtual void run();
+	private:
+		ThreadPool *_pool;
+	};
+
+	TaskPtr nextTask();
+
+	IceUtil::Monitor<IceUtil::Mutex> _monitor;
+	std::list<TaskPtr> _queue;
+	std::vector<IceUtil::ThreadControl> _workers;
+	int _maxQueued;
+	bool _destroyed;
+};
+
+typedef IceUtil::Handle<ThreadPool> ThreadPoolPtr;
+
+#endif
@@ -1,190 +1,165 @@
 #include <iostream>
-#include "Input.h"
-#include "Output.h"
-#include "FindOptSchedule.h"
+#include "BlackBoxI.h"
 #include "LCO.h"
 #include <Ice/Ice.h>
-#include <ctime>
-#include "SenStore.h"
+#include <IceStorm/IceStorm.h>
+#include "ThreadPool.h"
+#include "SenStorePool.h"
+#include "SenStoreStandIn.h"
+#include "ReferenceData.h"
+#include "DecayCache.h"
+#include "ResultCache.h"
+#include "LatencyStats.h"
+#include "BlackBoxAdminI.h"
+#include "Logger.h"
 
 using namespace std;
 using namespace LCO;
-using namespace SenStore;
-
-class BlackBoxI : public BlackBox {
-public:
-	virtual void optSchedule(const UserInput& userIn, const ComponentRatingMat& ratings, const RepairInfoMat& repairInfo, const ::Ice::Current&);
-};
-
-
-/*
- * Class: BlackBoxI
- * -------------------------------------------------------
- * BlackBoxI is the incarnation of the interface BlackBox
- * It contains the implementation of the operation optSchedule
- */
-void 
-BlackBoxI::
-optSchedule(const UserInput& userIn, const ComponentRatingMat& ratings, const RepairInfoMat& repairUserIn, const ::Ice::Current&)
-{	
-	int optObj = userIn.optObject;
-	OptimizationObjective objective = (OptimizationObjective)(optObj -1);
-	EnvImpactType impactType = findEnvImpactType(optObj);
-	Unit unit = findUnit(optObj);
-	int limit = userIn.ratingLowerLimit;
-
-	/* Server Input */
-	ServerInput serverIn;	
-	serverIn = readServerInput(userIn.bridgeID, userIn.componentID);
-
-	//ratingsdecay[x][y] is the years taken for rating "x" decreasing to "y" witout maintenance
-	int ratingsDecay[10][10];
-	ComponentRatingMat ServerRatings = readRatings(userIn.bridgeID,1); // Commented to use the ratings from userInput
-	ratingDecay(ratingsDecay,ServerRatings,limit);
-	BridgeInfo bridge = bridgeInfoCompiler(userIn, serverIn);
-	CostMap costs = readRepairCost(repairUserIn);
-
-	ImproveMat impMat;
-	ImpCoef cond4;
-	cond4.condition = 4;
-	cond4.coef = 0.15;
-
-	ImpCoef cond5;
-	cond5.condition = 5;
-	cond5.coef = 0.1;
-
-	ImpCoef cond6;
-	cond6.condition = 6;
-	cond6.coef = 0.05;
-
-	impMat.push_back(cond4);
-	impMat.push_back(cond5);
-	impMat.push_back(cond6);
-
-	/* prepare envMat */
-	RepairBasicInfoMat repairs;
-	repairs = readRepairBasicInfo();
-	//cout << repairs.size() << endl;
-	
-	EnvCoefMat envCos;
-	envCos = readEnvCoef(optObj);
-
-	//RepairEnvMat envMat;
-	//string type = "joint";	
-	//envMat = envInfoCompiler(repairUserIn, type, repairs, envCos);
-
-	//RepairSchedule optSchedule;
-	//findOptEnvSchedule(bridge, ratingsDecay, envMat, impMat, limit, optSchedule);
-	////findOptCostSchedule(bridge, ratingsDecay, envMat, costs, impMat, limit, optSchedule);
-	//cout << "Success" << endl;
-	
-	RepairEnvMat envMat;
-	RepairEnvMat envMat2;
-	RepairEnvMat envMat3;
-	RepairEnvMat envMat4;
-	string type;
-	RepairSchedule optSchedule;
-
-	switch(serverIn.componentType) {
-		case StructureComponentTypeDeck:
-			cout << "The selected component is StructureComponentTypeDECK" << endl;
-			type = "Deck";
-			envMat = envInfoCompiler(repairUserIn, type, repairs, envCos);
-			break;
-		case StructureComponentTypeAbutment:
-			cout << "The selected component is StructureComponentTypeABUTMENT" << endl;
-			type = "Foundation";
-			envMat = envInfoCompiler(repairUserIn, type, repairs, envCos);
-			break;
-		case StructureComponentTypePinHanger:
-			cout << "The selected component is StructureComponentTypePINHANGER" << endl;
-			type = "PinHanger";
-			envMat = envInfoCompiler(repairUserIn, type, repairs, envCos);
-			break;
-		case StructureComponentTypeSpan:
-			cout << "The selected component is StructureComponentTypeSPAN" << endl;
-			type = "Deck";
-			envMat = envInfoCompiler(repairUserIn, type, repairs, envCos);
-			type = "Barrier";
-			envMat2 = envInfoCompiler(repairUserIn, type, repairs, envCos);
-			type = "Joint";
-			envMat3 = envInfoCompiler(repairUserIn, type, repairs, envCos);
-			type = "Other";
-			envMat4 = envInfoCompiler(repairUserIn, type, repairs, envCos);
-			break;
-		case StructureComponentTypeColumn:
-			cout << "The selected component is StructureComponentTypeCOLUMN" << endl;
-			type = "Column";
-			envMat = envInfoCompiler(repairUserIn, type, repairs, envCos);
-			break;
-		default:
-			throw BlackBoxError("Unidentified ComponentType");
-	}
-	/* initiate a clock to calculate the computational cost of the algorithm */
-	std::clock_t start;
-	double duration;
-	start = std::clock();
-	//date
-	double date = sysDate();
-
-	if(optObj == 11) {
-			float minCost = findOptCostSchedule(bridge, ratingsDecay, envMat, costs, impMat, limit, optSchedule);
-			if (serverIn.componentType==StructureComponentTypeSpan) {
-				RepairSchedule optSchedule2;
-				RepairSchedule optSchedule3;
-				RepairSchedule optSchedule4;
-				float minCost2 = findOptCostSchedule(bridge, ratingsDecay, envMat2, costs, impMat, limit, optSchedule2);
-				float minCost3 = findOptCostSchedule(bridge, ratingsDecay, envMat3, costs, impMat, limit, optSchedule3);
-				float minCost4 = findOptCostSchedule(bridge, ratingsDecay, envMat4, costs, impMat, limit, optSchedule4);
-				minCost = minCost + minCost2 + minCost3 + minCost4;
-				optSchedule = mergeFourSched(optSchedule,  optSchedule2,  optSchedule3, optSchedule4);
-			}
-			writeToServer(userIn.bridgeID, userIn.componentID, objective, date, impactType, unit, minCost);
-	} else {
-			float minCost = findOptEnvSchedule(bridge, ratingsDecay, envMat, impMat, limit, optSchedule);
-			if (serverIn.componentType == StructureComponentTypeSpan) {
-				RepairSchedule optSchedule2;
-				RepairSchedule optSchedule3;
-				RepairSchedule optSchedule4;
-				float minCost2 = findOptEnvSchedule(bridge, ratingsDecay, envMat2, impMat, limit, optSchedule2);
-				float minCost3 = findOptEnvSchedule(bridge, ratingsDecay, envMat3, impMat, limit, optSchedule3);
-				float minCost4 = findOptEnvSchedule(bridge, ratingsDecay, envMat4, impMat, limit, optSchedule4);
-				minCost = minCost + minCost2 + minCost3 + minCost4;
-				optSchedule = mergeFourSched(optSchedule,  optSchedule2,  optSchedule3, optSchedule4);
-			}
-			writeToServer(userIn.bridgeID, userIn.componentID, objective, date, impactType, unit, minCost);
-	}
-
-	duration = ( std::clock() - start ) / (double) CLOCKS_PER_SEC;
-	std::cout<<"Computational Cost:"<< duration <<endl;
-}
 
 int main(int argc, char*argv[])
 {	
 	int status = 0;
 	Ice::CommunicatorPtr ic;
+	ThreadPoolPtr requestPool;
+	ThreadPoolPtr solverPool;
+	ReferenceDataWatcherPtr watcher;
+	IceUtil::ThreadControl watcherControl;
+	IceStorm::TopicPrx decayTopic;
+	Ice::ObjectPrx decaySubscriber;
 
 	try {
-		ic = Ice::initialize(argc, argv);
+		Ice::InitializationData initData;
+		initData.properties = Ice::createProperties(argc, argv);
+		// optSchedule is dispatched asynchronously, so a few dispatch threads are enough
+		// to keep accepting requests while the workers solve
+		if (initData.properties->getProperty("Ice.ThreadPool.Server.Size").empty())
+			initData.properties->setProperty("Ice.ThreadPool.Server.Size", "2");
+		ic = Ice::initialize(argc, argv, initData);
+
+		Ice::PropertiesPtr props = ic->getProperties();
+
+		// messages below BlackBox.Log.Level (debug, info, warning, error or none) are not
+		// written; the others wait for the logging thread in a queue of BlackBox.Log.BufferSize
+		// messages, and are dropped if it is full. The debug messages need a Debug build
+		LogLevel threshold = logLevel(props->getPropertyWithDefault("BlackBox.Log.Level", "info"));
+		startLogging(threshold, props->getPropertyAsIntWithDefault("BlackBox.Log.BufferSize", 4096));
+
+		// threads solving optSchedule requests, and how many requests may wait for one
+		// before new requests are refused with BlackBoxBusy
+		int workers = props->getPropertyAsIntWithDefault("BlackBox.Workers", 4);
+		int maxQueued = props->getPropertyAsIntWithDefault("BlackBox.MaxQueued", 64);
+		requestPool = new ThreadPool(workers, maxQueued);
+
+		// threads used to solve the sub-schedules of a span concurrently
+		int solverThreads = props->getPropertyAsIntWithDefault("BlackBox.Solver.Size", 4);
+		solverPool = new ThreadPool(solverThreads);
+
+		// proxies to SenStore kept open for the life of the server. SenStore.Proxy may also name
+		// a senStoreStandIn server; with SenStore.Backend=fixture, SenStore is answered inside this
+		// process from the files of SenStore.Fixtures, without the network
+		string senStoreProxy = props->getPropertyWithDefault("SenStore.Proxy", "SenStore:default -h panther.eecs.umich.edu -p 10004");
+		string senStoreBackend = props->getPropertyWithDefault("SenStore.Backend", "remote");
+		if (senStoreBackend == "fixture") {
+			Ice::ObjectAdapterPtr standInAdapter = ic->createObjectAdapterWithEndpoints("SenStoreStandInAdapter", "tcp -h 127.0.0.1");
+			Ice::ObjectPtr standIn = new SenStoreStandInI(props->getPropertyWithDefault("SenStore.Fixtures", "Fixtures"));
+			senStoreProxy = ic->proxyToString(standInAdapter->add(standIn, ic->stringToIdentity("SenStore")));
+			standInAdapter->activate();
+		} else if (senStoreBackend != "remote") {
+			throw BlackBoxError("Unknown SenStore.Backend " + senStoreBackend);
+		}
+		int senStoreConnections = props->getPropertyAsIntWithDefault("SenStore.Pool.Size", workers);
+		int senStoreCheck = props->getPropertyAsIntWithDefault("SenStore.Pool.CheckInterval", 30);
+		SenStorePoolPtr senStore = new SenStorePool(ic, senStoreProxy, senStoreConnections, senStoreCheck);
+
+		// the Data files are read once here; they are reread when they change on disk
+		// (checked every BlackBox.ReferenceData.PollInterval seconds, 0 to disable)
+		// or when BlackBoxAdmin::reloadReferenceData is called
+		ReferenceDataStorePtr referenceData = new ReferenceDataStore();
+		int pollInterval = props->getPropertyAsIntWithDefault("BlackBox.ReferenceData.PollInterval", 10);
+		if (pollInterval > 0) {
+			watcher = new ReferenceDataWatcher(referenceData, pollInterval);
+			watcherControl = watcher->start();
+		}
+
+		// ratings and deterioration curves are kept for BlackBox.DecayCache.TTL seconds (0 to disable)
+		int decayTTL = props->getPropertyAsIntWithDefault("BlackBox.DecayCache.TTL", 600);
+		DecayCachePtr decayCache = new DecayCache(decayTTL);
+
+		// the results of the last BlackBox.ResultCache.Size optSchedule requests (0 to disable),
+		// answered again for BlackBox.ResultCache.TTL seconds
+		int resultCapacity = props->getPropertyAsIntWithDefault("BlackBox.ResultCache.Size", 256);
+		int resultTTL = props->getPropertyAsIntWithDefault("BlackBox.ResultCache.TTL", 600);
+		ResultCachePtr resultCache = new ResultCache(resultCapacity, resultTTL);
+
+		// the stages of optSchedule are timed for BlackBoxAdmin::getStats
+		LatencyStatsPtr latency = new LatencyStats();
+
 		Ice::ObjectAdapterPtr adapter
 		= ic->createObjectAdapterWithEndpoints("BlackBoxAdapter", "default -p 10000");
-		Ice::ObjectPtr object = new BlackBoxI;
+
+		// with BlackBox.DecayCache.TopicManager set, the SenStore events published on
+		// BlackBox.DecayCache.Topic drop the cache as soon as an assessment changes;
+		// without it, or if IceStorm cannot be reached, the entries only expire
+		string topicManager = props->getProperty("BlackBox.DecayCache.TopicManager");
+		if (decayTTL > 0 && !topicManager.empty()) {
+			try {
+				IceStorm::TopicManagerPrx manager = IceStorm::TopicManagerPrx::checkedCast(ic->stringToProxy(topicManager));
+				if (!manager)
+					throw BlackBoxError("Invalid topic manager proxy");
+				string topicName = props->getPropertyWithDefault("BlackBox.DecayCache.Topic", "SignalDataUpdated");
+				try {
+					decayTopic = manager->retrieve(topicName);
+				} catch (const IceStorm::NoSuchTopic&) {
+					decayTopic = manager->create(topicName);
+				}
+				Ice::StringSeq classes = props->getPropertyAsListWithDefault("BlackBox.DecayCache.Classes",
+					Ice::StringSeq(1, "StructureComponentAssessment"));
+				decaySubscriber = adapter->addWithUUID(new DecayCacheEventsI(decayCache, classes))->ice_oneway();
+				decayTopic->subscribeAndGetPublisher(IceStorm::QoS(), decaySubscriber);
+			} catch (const Ice::Exception& ex) {
+				LOG_WARNING("Decay cache not subscribed to SenStore events: " << ex);
+				decayTopic = 0;
+			}
+		}
+
+		Ice::ObjectPtr object = new BlackBoxI(requestPool, solverPool, senStore, referenceData, decayCache, resultCache, latency);
 		adapter->add(object,ic->stringToIdentity("BlackBox"));
+		adapter->add(new BlackBoxAdminI(referenceData, resultCache, decayCache, requestPool, latency),ic->stringToIdentity("BlackBoxAdmin"));
 		adapter->activate();
 		ic->waitForShutdown();
 	} catch (BlackBoxError& ex) {
-		cout << ex.reason<<endl;
+		LOG_ERROR(ex.reason);
 		status = 1;
 	}
 
+	if (decayTopic) {
+		try {
+			decayTopic->unsubscribe(decaySubscriber);
+		} catch (const Ice::Exception& ex) {
+			LOG_WARNING(ex);
+		}
+	}
+
+	if (watcher) {
+		watcher->destroy();
+		watcherControl.join();
+	}
+
+	// finish the queued requests before their solver threads go away
+	if (requestPool)
+		requestPool->destroy();
+	if (solverPool)
+		solverPool->destroy();
+
 	if(ic) {
 		try{
 			ic->destroy();
 		} catch(const Ice::Exception&e) {
-			cerr << e << endl;
+			LOG_ERROR(e);
 			status = 1;
 		}
 	}	
+	stopLogging();
 
 	system("PAUSE");
 	return status;
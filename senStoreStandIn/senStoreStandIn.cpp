@@ -0,0 +1,58 @@
+//
+//  senStoreStandIn.cpp
+//  senStoreStandIn
+//
+//  A server answering the SenStoreMngr operations of the black box from fixture files, so
+//  that the black box can be run and load tested against it as against SenStore.
+//
+//  Usage: senStoreStandIn [--SenStore.Fixtures=dir] [--SenStoreStandIn.Endpoints=endpoints]
+//
+
+#include <iostream>
+#include <Ice/Ice.h>
+#include "LCO.h"
+#include "SenStoreStandIn.h"
+
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+	int status = 0;
+	Ice::CommunicatorPtr ic;
+
+	try {
+		Ice::InitializationData initData;
+		initData.properties = Ice::createProperties(argc, argv);
+		// the requests of a loaded black box arrive on several connections at once
+		if (initData.properties->getProperty("Ice.ThreadPool.Server.Size").empty())
+			initData.properties->setProperty("Ice.ThreadPool.Server.Size", "4");
+		ic = Ice::initialize(argc, argv, initData);
+
+		// the black box finds SenStore as "SenStore" on port 10004 by default
+		Ice::PropertiesPtr props = ic->getProperties();
+		string endpoints = props->getPropertyWithDefault("SenStoreStandIn.Endpoints", "default -p 10004");
+		string fixtures = props->getPropertyWithDefault("SenStore.Fixtures", "..\\blackBox\\Fixtures");
+
+		Ice::ObjectAdapterPtr adapter = ic->createObjectAdapterWithEndpoints("SenStoreStandInAdapter", endpoints);
+		adapter->add(new SenStoreStandInI(fixtures), ic->stringToIdentity("SenStore"));
+		adapter->activate();
+		cout << "SenStore stand-in serving " << fixtures << " on " << endpoints << endl;
+		ic->waitForShutdown();
+	} catch (const LCO::BlackBoxError &ex) {
+		cerr << ex.reason << endl;
+		status = 1;
+	} catch (const Ice::Exception &ex) {
+		cerr << ex << endl;
+		status = 1;
+	}
+
+	if (ic) {
+		try {
+			ic->destroy();
+		} catch (const Ice::Exception &ex) {
+			cerr << ex << endl;
+			status = 1;
+		}
+	}
+	return status;
+}
@@ -0,0 +1,347 @@
+#include <math.h>
+#include <limits>
+#include <set>
+#include "BaselineKernels.h"
+
+/*
+ * Implementation: baselineEnvImpact
+ * ------------------------------
+ * impCoeff starts at 0 for ratings without a coefficient, which calEnvImpact also uses.
+ */
+float baselineEnvImpact(BridgeInfo bridge, int year, int repairID, int rating, RepairEnvMat repairs, ImproveMat impMat) {
+    float deckLength = bridge.bridgeLength;
+    float deckWidth = bridge.bridgeWidth;
+    float AADT = bridge.bridgeAADT;
+    float growthRate = bridge.trafficGrowthRate;
+    float meanRepair;
+    float meanTraffic;
+    int days;
+    float impCoeff = 0.0f;
+
+	for ( int i = 0; i < impMat.size(); i++ ) {
+		if (impMat[i].condition == rating)
+			impCoeff = impMat[i].coef;
+	}
+
+	float CO2 = 0.0f;
+
+    /* calculations fall in to 11 categories depending on its repairID; each has its own equation */
+    int categoryOne[] = {1, 7 , 15, 16};
+    set<int> one(categoryOne,categoryOne+4);
+    int categoryTwo[] = {2};
+    set<int> two(categoryTwo,categoryTwo+1);
+    int categoryThree[] = {3, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34,45};
+    set<int> three(categoryThree,categoryThree+14);
+    int categoryFour[] = {4, 10};
+    set<int> four(categoryFour, categoryFour+2);
+    int categoryFive[] = {5};
+    set<int> five(categoryFive,categoryFive+1);
+    int categorySix[] = {6, 37, 38, 39, 40};
+    set<int> six(categorySix, categorySix+5);
+    int categorySeven[] = {8, 9, 41, 42, 43, 44, 46, 47, 48, 49, 50};
+    set<int> seven(categorySeven, categorySeven+11);
+    int categoryEight[] = { 11, 51 };
+    set<int> eight(categoryEight, categoryEight+2);
+    int categoryNine[] = {12, 13, 14};
+    set<int> nine(categoryNine, categoryNine+3);
+    int categoryTen[] = {17, 18 ,19, 20, 21, 35, 36};
+    set<int> ten(categoryTen, categoryTen+ 7);
+    int categoryEleven[] = {0};
+    set<int> eleven(categoryEleven, categoryEleven +1 );
+
+    if (one.count(repairID) == 1) {
+        for (int j = 0; j < repairs.size() ; j++) {
+            if (repairs[j].repairID == repairID && (rating <= repairs[j].UB && rating >= repairs[j].LB) ) {
+                meanRepair = repairs[j].repairMean;
+                meanTraffic= repairs[j].trafficMean;
+                days = repairs[j].duration;
+                CO2 = meanRepair*deckLength*deckWidth*impCoeff + meanTraffic*AADT*days*pow(1+growthRate, year);
+                break;
+            }
+        }
+	} else if(two.count(repairID) == 1) {
+        for (int j = 0; j < repairs.size() ; j++) {
+            if (repairs[j].repairID == repairID && (rating <= repairs[j].UB && rating >= repairs[j].LB) ) {
+                meanRepair = repairs[j].repairMean;
+                meanTraffic= repairs[j].trafficMean;
+                days = repairs[j].duration;
+                CO2 = meanRepair* 10 * deckWidth*impCoeff + meanTraffic*AADT*days*pow(1+growthRate, year);
+                return CO2;
+            }
+        }
+    } else if(three.count(repairID) == 1) {
+        for (int j = 0; j < repairs.size() ; j++) {
+            if (repairs[j].repairID == repairID && (rating <= repairs[j].UB && rating >= repairs[j].LB) ) {
+                meanRepair = repairs[j].repairMean;
+                meanTraffic= repairs[j].trafficMean;
+                days = repairs[j].duration;
+                CO2 = meanRepair * deckWidth * meanTraffic * AADT * days * pow(1+growthRate, year);
+                break;
+            }
+        }
+    } else if(four.count(repairID) == 1) {
+        for (int j = 0; j < repairs.size() ; j++) {
+			 if (repairs[j].repairID == repairID && (rating <= repairs[j].UB && rating >= repairs[j].LB) ) {
+                meanRepair = repairs[j].repairMean;
+                CO2 = meanRepair*deckLength* 2 * impCoeff;
+                break;
+             }
+        }
+    } else if(five.count(repairID) == 1) {
+        for (int j = 0; j < repairs.size() ; j++) {
+            if (repairs[j].repairID == repairID && (rating <= repairs[j].UB && rating >= repairs[j].LB) ) {
+                meanRepair = repairs[j].repairMean;
+                CO2 = meanRepair*deckLength*deckWidth;
+                break;
+            }
+        }
+    } else if(six.count(repairID) == 1) {
+        for (int j = 0; j < repairs.size() ; j++) {
+            if (repairs[j].repairID == repairID && (rating <= repairs[j].UB && rating >= repairs[j].LB) ) {
+                meanRepair = repairs[j].repairMean;
+                CO2 = meanRepair*deckLength*deckWidth*impCoeff;
+                break;
+            }
+        }
+    } else if(seven.count(repairID) == 1) {
+        // no information available
+        CO2 = 0;
+    } else if(eight.count(repairID) == 1) {
+        for (int j = 0; j < repairs.size() ; j++) {
+            if (repairs[j].repairID == repairID && (rating <= repairs[j].UB && rating >= repairs[j].LB) ) {
+                meanRepair = repairs[j].repairMean;
+                CO2 = meanRepair;
+                break;
+            }
+        }
+    } else if(nine.count(repairID) == 1) {
+        for (int j = 0; j < repairs.size() ; j++) {
+            if (repairs[j].repairID == repairID && (rating <= repairs[j].UB && rating >= repairs[j].LB) ) {
+                meanRepair = repairs[j].repairMean;
+                meanTraffic= repairs[j].trafficMean;
+                days = repairs[j].duration;
+                CO2 = meanRepair*deckLength*2*impCoeff*meanTraffic*AADT*days*pow(1+growthRate, year);
+                break;
+            }
+        }
+    } else if(ten.count(repairID) == 1) {
+        for (int j = 0; j < repairs.size() ; j++) {
+            if (repairs[j].repairID == repairID && (rating <= repairs[j].UB && rating >= repairs[j].LB) ) {
+                meanRepair = repairs[j].repairMean;
+                meanTraffic= repairs[j].trafficMean;
+                days = repairs[j].duration;
+                CO2 = meanRepair*deckLength*deckWidth + meanTraffic*AADT*days*pow(1+growthRate, year);
+                break;
+            }
+        }
+    } else if(eleven.count(repairID) == 1) {
+        for (int j = 0; j < repairs.size() ; j++) {
+            if (repairs[j].repairID == repairID && (rating <= repairs[j].UB && rating >= repairs[j].LB) ) {
+                meanRepair = repairs[j].repairMean;
+                meanTraffic= repairs[j].trafficMean;
+                days = repairs[j].duration;
+                CO2 = meanRepair*deckLength*deckWidth*impCoeff * meanTraffic*AADT*days*pow(1+growthRate, year);
+                break;
+            }
+        }
+    }
+
+    return CO2;
+}
+
+/*
+ * Function: baselineBacktrack
+ * Usage: minimum = baselineBacktrack(M, preX, preY, preRepair, bridge, limit, optSchedule);
+ * -------------------------------------------------------
+ * The cheapest final condition of year 100 and the repairs leading to it, earliest first,
+ * as both original DPs ended.
+ */
+static float baselineBacktrack(float M[][9], int preX[][9], int preY[][9], int preRepair[][9], const BridgeInfo &bridge, int limit, RepairSchedule &optSchedule) {
+    float minTotalCost = numeric_limits<float>::infinity();
+    int optFinalCondition = limit;
+    for (int i = limit; i < 8; i++) {
+        if (M[100][i] < minTotalCost) {
+            minTotalCost = M[100][i];
+            optFinalCondition = i;
+        }
+    }
+
+    int x = 100;
+    int y = optFinalCondition;
+	RepairSchedule temp;
+    while (preX[x][y]>-1 && preRepair[x][y]>0){
+		Pair oneRepair;
+		oneRepair.repairYear = preX[x][y] + bridge.startYear;
+        oneRepair.repairID = preRepair[x][y];
+		oneRepair.value = 0;
+		temp.push_back(oneRepair);
+        int tempX = x;
+        x=preX[x][y];
+        y=preY[tempX][y];
+    }
+	for( int n = temp.size()-1; n >-1;n--) {
+		optSchedule.push_back(temp[n]);
+	}
+	return minTotalCost;
+}
+
+/*
+ * Implementation: baselineEnvSchedule
+ * ------------------------------
+ * The originals read preX of states that neither the boundary nor the fill had written, so
+ * every state starts with no predecessor here.
+ */
+float baselineEnvSchedule(BridgeInfo bridge, int ratingsDecay[][10], RepairEnvMat repairs, ImproveMat impMat, int limit, RepairSchedule &optSchedule) {
+    int preX[101][9],preY[101][9],preRepair[101][9];
+    float M[101][9];
+    for(int i=0; i<101; i++)
+        for(int j=0; j<9;j++) {
+            M[i][j]=0;
+            preX[i][j]=-1;
+            preY[i][j]=0;
+            preRepair[i][j]=0;
+        }
+
+	int startRating = bridge.startRating;
+
+    //boundary conditions
+    for(int rating = startRating-1; rating >limit-1; rating--) {
+        for (int year = ratingsDecay[startRating][rating+1]; year <= ratingsDecay[startRating][rating];year++){
+            for(int i = 8; i> 0; i--){
+                if (i >= rating)
+                    M[year][i] = 0;
+                else
+                    M[year][i] = numeric_limits<float>::infinity();
+                preX[year][i] = -1;
+                preY[year][i] = 0;
+                preRepair[year][i] = 0;
+            }
+        }
+    }
+
+    for(int year=0;year<101; year++){
+        for(int rating=limit; rating<9; rating++ ){
+            if ( rating <= startRating && ratingsDecay[startRating][rating] >= year)
+                continue;
+
+            float min= numeric_limits<float>::infinity();
+            float tempCost=0;
+            for(int i=rating+1;i<9;i++){
+                int yearDecay=year-ratingsDecay[i][rating];
+                if(yearDecay < 0)
+					break;
+
+                float repairCost= numeric_limits<float>::infinity();
+                int repairId=0;
+                for (int j=limit;j<i;j++){
+                    for (int k=0;k<repairs.size();k++){
+						float tempRepairCost;
+						if (i == 7 && repairs[k].improvement == 7 && (j <= repairs[k].UB && j >= repairs[k].LB)) {
+							tempRepairCost = baselineEnvImpact(bridge, yearDecay, repairs[k].repairID, j, repairs, impMat);
+							if (tempRepairCost < repairCost) {
+								repairId = repairs[k].repairID;
+								repairCost = tempRepairCost;
+							}
+						} else if (repairs[k].improvement==i-j && (j <= repairs[k].UB && j >= repairs[k].LB) ) {
+                            tempRepairCost = baselineEnvImpact(bridge, yearDecay, repairs[k].repairID, j, repairs, impMat);
+							if (tempRepairCost < repairCost) {
+								repairId = repairs[k].repairID;
+								repairCost = tempRepairCost;
+							}
+						}
+                    }
+
+                    tempCost=M[yearDecay][j]+ repairCost;
+                    if (tempCost <= min && tempCost!=0 && preX[yearDecay][j]!=yearDecay){//prevent multiple repairs happen in the same year
+                        min=tempCost;
+                        preX[year][rating]=yearDecay;
+                        preY[year][rating]=j;
+                        preRepair[year][rating]=repairId;
+                    }
+                }
+            }
+			M[year][rating]=min;
+        }
+    }
+
+	return baselineBacktrack(M, preX, preY, preRepair, bridge, limit, optSchedule);
+}
+
+float baselineCostSchedule(BridgeInfo bridge, int ratingsDecay[][10], RepairEnvMat repairs, CostMap costs, ImproveMat impMat, int limit, RepairSchedule &optSchedule) {
+    int preX[101][9],preY[101][9],preRepair[101][9];
+    float M[101][9];
+    for(int i=0; i<101; i++)
+        for(int j=0; j<9;j++) {
+            M[i][j]=0;
+            preX[i][j]=-1;
+            preY[i][j]=0;
+            preRepair[i][j]=0;
+        }
+
+	int startRating = bridge.startRating;
+	float r = bridge.discountRate;
+
+    //boundary conditions
+    for(int rating = startRating-1; rating >limit-1; rating--) {
+        for (int year = ratingsDecay[startRating][rating+1]; year <= ratingsDecay[startRating][rating];year++){
+            for(int i = 8; i> 0; i--){
+                if (i >= rating)
+                    M[year][i] = 0;
+                else
+                    M[year][i] = numeric_limits<float>::infinity();
+                preX[year][i] = -1;
+                preY[year][i] = 0;
+                preRepair[year][i] = 0;
+            }
+        }
+    }
+
+    for(int year=0;year<101; year++){
+        for(int rating=limit; rating<9; rating++ ){
+            if ( rating <= startRating && ratingsDecay[startRating][rating] >= year)
+                continue;
+
+            float min= numeric_limits<float>::infinity();
+            float tempCost=0;
+            for(int i=rating;i<9;i++){
+                int yearDecay=year-ratingsDecay[i][rating];
+                if(yearDecay < 0)
+					break;
+
+                float repairCost= numeric_limits<float>::infinity();
+                int repairId=0;
+                for (int j=limit;j<i;j++){
+                    for (int k=0;k<repairs.size();k++){
+						float tempRepairCost;
+						if (i == 7 && repairs[k].improvement == 7 && (j <= repairs[k].UB && j >= repairs[k].LB)) {
+							float factor = costs[repairs[k].repairID];
+							tempRepairCost = baselineEnvImpact(bridge, yearDecay, repairs[k].repairID, j, repairs, impMat)*factor/pow(r+1, yearDecay);
+							if (tempRepairCost < repairCost) {
+								repairId = repairs[k].repairID;
+								repairCost = tempRepairCost;
+							}
+						} else if (repairs[k].improvement==i-j && (j <= repairs[k].UB && j >= repairs[k].LB) ) {
+							float factor = costs[repairs[k].repairID];
+                            tempRepairCost = baselineEnvImpact(bridge, yearDecay, repairs[k].repairID, j, repairs, impMat)*factor/pow(r+1, yearDecay);
+							if (tempRepairCost < repairCost) {
+								repairId = repairs[k].repairID;
+								repairCost = tempRepairCost;
+							}
+						}
+                    }
+
+                    tempCost=M[yearDecay][j]+ repairCost;
+                    if (tempCost < min && tempCost!=0 && preX[yearDecay][j]!=yearDecay){//every year only perform one repair
+                        min=tempCost;
+                        preX[year][rating]=yearDecay;
+                        preY[year][rating]=j;
+                        preRepair[year][rating]=repairId;
+                    }
+                }
+            }
+			M[year][rating]=min;
+        }
+    }
+
+	return baselineBacktrack(M, preX, preY, preRepair, bridge, limit, optSchedule);
+}
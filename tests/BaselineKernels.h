@@ -0,0 +1,37 @@
+//
+//  BaselineKernels.h
+//  tests
+//
+//  The schedule DPs and calEnvImpact as they were before the repair-cost tables, the year
+//  factors and the shared kernel, kept as the reference the current code is checked against
+//  and timed against by the benchmark.
+//
+
+#ifndef tests_BaselineKernels_h
+#define tests_BaselineKernels_h
+
+#include "Input.h"
+#include "FindOptSchedule.h"
+
+/*
+ * Function: baselineEnvImpact
+ * Usage: impact = baselineEnvImpact(bridge, year, repairID, rating, repairs, impMat);
+ * ----------------------------------------------------------------------------------------------------------
+ * The original calEnvImpact: finds the formula of the repairID in the category sets and the
+ * coefficients in "repairs" on every call, and evaluates pow(1+growthRate, year).
+ */
+float baselineEnvImpact(BridgeInfo bridge, int year, int repairID, int rating, RepairEnvMat repairs, ImproveMat impMat);
+
+/*
+ * Function: baselineEnvSchedule, baselineCostSchedule
+ * Usage: minimum = baselineEnvSchedule(bridge, ratingsDecay, repairs, impMat, limit, optSchedule);
+ * ----------------------------------------------------------------------------------------------------------
+ * The original findOptEnvSchedule and findOptCostSchedule, over the fixed horizon of 101 years and
+ * 9 ratings, scanning every repair of every transition. They write no report, and start the
+ * predecessor arrays at "none" where the originals left them uninitialized.
+ * Returns the minimum envImpact or cost
+ */
+float baselineEnvSchedule(BridgeInfo bridge, int ratingsDecay[][10], RepairEnvMat repairs, ImproveMat impMat, int limit, RepairSchedule &optSchedule);
+float baselineCostSchedule(BridgeInfo bridge, int ratingsDecay[][10], RepairEnvMat repairs, CostMap costs, ImproveMat impMat, int limit, RepairSchedule &optSchedule);
+
+#endif
@@ -0,0 +1,171 @@
+//
+//  DecaySamplingTest.cpp
+//  tests
+//
+//  The random streams, the sampled decay curves and the statistics of optScheduleUncertainty.
+//  The result of a solve must depend on its seed only.
+//
+
+#include <math.h>
+#include "Tests.h"
+#include "DecaySampling.h"
+
+/*
+ * Function: quadraticRatings
+ * -------------------------------------------------------
+ * Three ratings on the curve 10 - (t+10)^2/100, so that the fit has no residuals.
+ */
+static ComponentRatingMat quadraticRatings()
+{
+	ComponentRatingMat ratings;
+	const int t[3] = { 0, 10, 20 };
+	for (int i = 0; i < 3; i++) {
+		ratings.years.push_back(1990 + t[i]);
+		ratings.ratings.push_back(10 - (t[i] + 10)*(t[i] + 10)/100);
+	}
+	return ratings;
+}
+
+/*
+ * Function: noisyRatings
+ * -------------------------------------------------------
+ * Assessments every four years that do not lie on a quadratic.
+ */
+static ComponentRatingMat noisyRatings()
+{
+	ComponentRatingMat ratings;
+	const int rating[9] = { 9, 9, 8, 8, 7, 6, 5, 3, 2 };
+	for (int i = 0; i < 9; i++) {
+		ratings.years.push_back(1990 + 4*i);
+		ratings.ratings.push_back(rating[i]);
+	}
+	return ratings;
+}
+
+/*
+ * Function: sameDecay
+ * -------------------------------------------------------
+ * Whether the years from every rating down to every lower one, to "limit", are the same;
+ * ratingDecay does not fill in the others.
+ */
+static bool sameDecay(int decay[][10], int expected[][10], int limit)
+{
+	for (int i = 9; i >= limit; i--) {
+		for (int j = i; j >= limit; j--) {
+			if (decay[i][j] != expected[i][j])
+				return false;
+		}
+	}
+	return true;
+}
+
+static void sampleStreamTests()
+{
+	SampleStream first(7, 3), again(7, 3), otherStream(7, 4), otherSeed(8, 3);
+	bool same = true, differsByStream = false, differsBySeed = false, inRange = true;
+	for (int i = 0; i < 1000; i++) {
+		int value = first.uniform(100);
+		same = same && again.uniform(100) == value;
+		differsByStream = differsByStream || otherStream.uniform(100) != value;
+		differsBySeed = differsBySeed || otherSeed.uniform(100) != value;
+		inRange = inRange && value >= 0 && value < 100;
+	}
+	CHECK(same, "the same seed and stream give other numbers");
+	CHECK(differsByStream, "two streams of a seed give the same numbers");
+	CHECK(differsBySeed, "two seeds give the same numbers");
+	CHECK(inRange, "uniform(100) is out of 0-99");
+}
+
+/*
+ * Function: decaySamplerTests
+ * -------------------------------------------------------
+ * Without residuals every sample is the fitted curve itself.
+ */
+static void decaySamplerTests()
+{
+	const int limit = 4;
+	DecaySampler exact(quadraticRatings());
+	int fitted[10][10], sampled[10][10];
+	ratingDecay(fitted, exact.coefficients(), limit);
+	SampleStream random(1, 0);
+	CHECK(exact.sample(random, limit, sampled), "a curve without residuals was rejected");
+	CHECK(sameDecay(sampled, fitted, limit), "a sample without residuals differs from the fit");
+
+	DecaySampler noisy(noisyRatings());
+	int noisyFitted[10][10];
+	ratingDecay(noisyFitted, noisy.coefficients(), limit);
+	SampleStream first(5, 2), again(5, 2);
+	bool same = true, varies = false;
+	for (int s = 0; s < 200; s++) {
+		int decay[10][10], decayAgain[10][10];
+		bool accepted = noisy.sample(first, limit, decay);
+		same = same && noisy.sample(again, limit, decayAgain) == accepted;
+		if (!accepted)
+			continue;
+		same = same && sameDecay(decay, decayAgain, limit);
+		varies = varies || !sameDecay(decay, noisyFitted, limit);
+	}
+	CHECK(same, "the same stream sampled other curves");
+	CHECK(varies, "every sample with residuals is the fit");
+}
+
+static void summarizeSamplesTests()
+{
+	vector<float> values;
+	for (int i = 100; i >= 1; i--)
+		values.push_back((float)i);
+	SampleSummary summary = summarizeSamples(values);
+	CHECK(summary.samples == 100, "samples of 1-100");
+	CHECK(summary.mean == 50.5f, "mean of 1-100");
+	CHECK(fabs(summary.stdDev - 28.866f) < 0.001f, "standard deviation of 1-100");
+	CHECK(summary.minimum == 1 && summary.maximum == 100, "range of 1-100");
+	CHECK(summary.p5 == 6 && summary.median == 51 && summary.p95 == 95, "percentiles of 1-100");
+
+	SampleSummary none = summarizeSamples(vector<float>());
+	CHECK(none.samples == 0 && none.mean == 0 && none.maximum == 0, "summary of no samples");
+}
+
+/*
+ * Function: timingSpreadTests
+ * -------------------------------------------------------
+ * The second repair 3 of the schedule is matched with the second repair 3 of a sample,
+ * whatever comes between them.
+ */
+static void timingSpreadTests()
+{
+	const int scheduled[3][2] = { { 3, 2010 }, { 5, 2020 }, { 3, 2030 } };
+	const int firstSample[3][2] = { { 3, 2012 }, { 5, 2020 }, { 3, 2032 } };
+	RepairSchedule schedule, sample;
+	for (int r = 0; r < 3; r++) {
+		Pair repair;
+		repair.repairID = scheduled[r][0];
+		repair.repairYear = scheduled[r][1];
+		repair.value = 0;
+		schedule.push_back(repair);
+		repair.repairID = firstSample[r][0];
+		repair.repairYear = firstSample[r][1];
+		sample.push_back(repair);
+	}
+	vector<RepairSchedule> samples(1, sample);
+	sample.resize(1);
+	sample[0].repairYear = 2008;
+	samples.push_back(sample);
+
+	vector<TimingSpread> spread = timingSpread(schedule, samples);
+	CHECK(spread.size() == 3, "one spread per repair of the schedule");
+	if (spread.size() != 3)
+		return;
+	CHECK(spread[0].repairID == 3 && spread[0].year == 2010, "first repair of the spread");
+	CHECK(spread[0].frequency == 1.0f && spread[0].meanYear == 2010 && spread[0].stdDevYear == 2, "spread of the first repair 3");
+	CHECK(spread[0].earliest == 2008 && spread[0].latest == 2012, "years of the first repair 3");
+	CHECK(spread[1].frequency == 0.5f && spread[1].meanYear == 2020 && spread[1].stdDevYear == 0, "spread of repair 5");
+	CHECK(spread[2].frequency == 0.5f && spread[2].earliest == 2032 && spread[2].latest == 2032, "spread of the second repair 3");
+}
+
+void decaySamplingTests()
+{
+	sampleStreamTests();
+	decaySamplerTests();
+	summarizeSamplesTests();
+	timingSpreadTests();
+}
@@ -0,0 +1,130 @@
+//
+//  ResultCacheTest.cpp
+//  tests
+//
+//  The result cache of optSchedule: a repeated request gets the result it was stored with,
+//  any difference in the request, the reference data or the ratings misses, and the least
+//  recently used and expired results are dropped.
+//
+
+#include <IceUtil/IceUtil.h>
+#include "Tests.h"
+#include "ResultCache.h"
+
+static UserInput request(int optObject)
+{
+	UserInput userIn = UserInput();
+	userIn.bridgeID = 1;
+	userIn.componentID = 2;
+	userIn.discountRate = 0.04f;
+	userIn.optObject = optObject;
+	return userIn;
+}
+
+static RepairInfoMat userRepairs()
+{
+	RepairInfoMat repairs(2);
+	for (int r = 0; r < 2; r++) {
+		repairs[r].repairID = 3 + r;
+		repairs[r].duration = 5;
+		repairs[r].cost = 10000*(r + 1);
+		repairs[r].avail = true;
+	}
+	return repairs;
+}
+
+static ScheduleResult result(float minimum)
+{
+	ScheduleResult result;
+	result.minimum = minimum;
+	ScheduledRepair repair;
+	repair.repairID = 3;
+	repair.year = 2020;
+	repair.value = minimum;
+	result.schedule.push_back(repair);
+	return result;
+}
+
+static void hitTests()
+{
+	ResultCachePtr cache = new ResultCache(4, 60);
+	RepairInfoMat repairs = userRepairs();
+	ScheduleResult found;
+	CHECK(!cache->find(request(1), repairs, 1, 0, found), "an empty cache has a result");
+
+	cache->store(request(1), repairs, 1, 0, result(12.5f));
+	found = ScheduleResult();
+	CHECK(cache->find(request(1), repairs, 1, 0, found), "a stored request misses");
+	CHECK(found == result(12.5f), "a hit returns another result than the one stored");
+
+	cache->store(request(1), repairs, 1, 0, result(7.0f));
+	CHECK(cache->find(request(1), repairs, 1, 0, found) && found.minimum == 7.0f, "storing a request again does not replace its result");
+
+	UserInput otherRate = request(1);
+	otherRate.discountRate = 0.05f;
+	RepairInfoMat otherCost = repairs;
+	otherCost[1].cost++;
+	RepairInfoMat unavailable = repairs;
+	unavailable[0].avail = false;
+	CHECK(!cache->find(request(2), repairs, 1, 0, found), "another objective hits");
+	CHECK(!cache->find(otherRate, repairs, 1, 0, found), "another discount rate hits");
+	CHECK(!cache->find(request(1), otherCost, 1, 0, found), "another repair cost hits");
+	CHECK(!cache->find(request(1), unavailable, 1, 0, found), "an unavailable repair hits");
+	CHECK(!cache->find(request(1), repairs, 2, 0, found), "another reference data version hits");
+	CHECK(!cache->find(request(1), repairs, 1, 1, found), "another ratings generation hits");
+
+	CacheStats stats = cache->stats();
+	CHECK(stats.hits == 2 && stats.misses == 7, "hits and misses are miscounted");
+	CHECK(stats.entries == 1 && stats.capacity == 4, "entries and capacity are misreported");
+}
+
+/*
+ * Function: evictionTests
+ * -------------------------------------------------------
+ * A hit makes its result the most recently used, so the other one is dropped first.
+ */
+static void evictionTests()
+{
+	ResultCachePtr cache = new ResultCache(2, 60);
+	RepairInfoMat repairs = userRepairs();
+	ScheduleResult found;
+	cache->store(request(1), repairs, 1, 0, result(1));
+	cache->store(request(2), repairs, 1, 0, result(2));
+	cache->find(request(1), repairs, 1, 0, found);
+	cache->store(request(3), repairs, 1, 0, result(3));
+
+	CHECK(!cache->find(request(2), repairs, 1, 0, found), "the least recently used result was kept");
+	CHECK(cache->find(request(1), repairs, 1, 0, found) && found.minimum == 1, "a recently used result was dropped");
+	CHECK(cache->find(request(3), repairs, 1, 0, found) && found.minimum == 3, "the newest result was dropped");
+	CHECK(cache->stats().entries == 2, "the cache holds more than its capacity");
+}
+
+static void expiryTests()
+{
+	ResultCachePtr cache = new ResultCache(2, 1);
+	RepairInfoMat repairs = userRepairs();
+	ScheduleResult found;
+	cache->store(request(1), repairs, 1, 0, result(1));
+	CHECK(cache->find(request(1), repairs, 1, 0, found), "a fresh result misses");
+	IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(1100));
+	CHECK(!cache->find(request(1), repairs, 1, 0, found), "an expired result hits");
+	CHECK(cache->stats().entries == 0, "an expired result is kept");
+}
+
+static void disabledTests()
+{
+	ResultCachePtr cache = new ResultCache(0, 60);
+	RepairInfoMat repairs = userRepairs();
+	ScheduleResult found;
+	cache->store(request(1), repairs, 1, 0, result(1));
+	CHECK(!cache->find(request(1), repairs, 1, 0, found), "a cache of capacity 0 hits");
+	CHECK(cache->stats().entries == 0, "a cache of capacity 0 keeps results");
+}
+
+void resultCacheTests()
+{
+	hitTests();
+	evictionTests();
+	expiryTests();
+	disabledTests();
+}
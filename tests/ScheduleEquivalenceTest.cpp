@@ -0,0 +1,206 @@
+//
+//  ScheduleEquivalenceTest.cpp
+//  tests
+//
+//  findOptEnvSchedule and findOptCostSchedule, which run the shared DP kernel on the
+//  repair-cost tables, against the original kernels in BaselineKernels.cpp. Both must give
+//  the same minimum, bit for bit, and the same repairs in the same years.
+//
+
+#include <sstream>
+#include <algorithm>
+#include <math.h>
+#include "Tests.h"
+#include "BaselineKernels.h"
+#include "DecaySampling.h"
+
+// scenarios solved, drawn from one fixed seed so that every run checks the same ones
+static const int nScenarios = 400;
+static const unsigned int scenarioSeed = 12345;
+
+static const char *const componentTypes[] = { "Deck", "Joint", "Barrier", "Other", "Column", "Foundation", "PinHanger" };
+
+/*
+ * Function: uniformBetween
+ * -------------------------------------------------------
+ * A number in lo .. hi, each as likely.
+ */
+static int uniformBetween(SampleStream &random, int lo, int hi)
+{
+	return lo + random.uniform(hi - lo + 1);
+}
+
+/*
+ * Function: randomRatings
+ * -------------------------------------------------------
+ * Assessments every two to five years of a component decaying along a quadratic from 9.9,
+ * until it falls below 1 or 40 years have passed.
+ */
+static ComponentRatingMat randomRatings(SampleStream &random)
+{
+	ComponentRatingMat ratings;
+	float a = -0.001f*uniformBetween(random, 5, 24);
+	float b = -0.001f*uniformBetween(random, 0, 49);
+	for (int t = 0; t < 40 && ratings.ratings.size() < 15; t += uniformBetween(random, 2, 5)) {
+		int rating = (int)(9.9f + b*t + a*t*t);
+		if (rating < 1)
+			break;
+		ratings.years.push_back(1980 + t);
+		ratings.ratings.push_back(rating);
+	}
+	return ratings;
+}
+
+/*
+ * Function: randomRepairs
+ * -------------------------------------------------------
+ * The user's repairs: every repair of the basic info that the objective has coefficients for,
+ * with a random duration and cost, one in five of them not available.
+ */
+static RepairInfoMat randomRepairs(SampleStream &random, const RepairBasicInfoMat &basicInfo, const EnvCoefMat &envCoef)
+{
+	RepairInfoMat repairs;
+	for (int b = 0; b < basicInfo.size(); b++) {
+		bool known = false;
+		for (int e = 0; e < envCoef.size() && !known; e++)
+			known = envCoef[e].repairID == basicInfo[b].repairID;
+		for (int u = 0; u < repairs.size() && known; u++)
+			known = repairs[u].repairID != basicInfo[b].repairID;
+		if (!known)
+			continue;
+
+		RepairInfo repair;
+		repair.repairID = basicInfo[b].repairID;
+		repair.duration = uniformBetween(random, 1, 20);
+		repair.cost = uniformBetween(random, 1000, 50999);
+		repair.avail = random.uniform(5) != 0;
+		repairs.push_back(repair);
+	}
+	return repairs;
+}
+
+/*
+ * Function: randomBridge
+ * -------------------------------------------------------
+ * A bridge with the default horizon and rating scale, which the original kernels are fixed to.
+ */
+static BridgeInfo randomBridge(SampleStream &random, int bridgeID, int optObj)
+{
+	UserInput userIn;
+	userIn.bridgeID = bridgeID;
+	userIn.bridgeAADT = (float)uniformBetween(random, 1000, 20999);
+	userIn.bridgeAADTT = 100;
+	userIn.trafficGrowthRate = 0.001f*uniformBetween(random, 0, 49);
+	userIn.discountRate = 0.001f*uniformBetween(random, 10, 69);
+	userIn.componentID = 1;
+	userIn.ratingLowerLimit = 4;
+	userIn.startRating = uniformBetween(random, 6, 8);
+	userIn.startYear = uniformBetween(random, 2000, 2019);
+	userIn.optObject = optObj;
+	userIn.horizon = 0;
+	userIn.ratingLevels = 0;
+	ServerInput serverIn;
+	serverIn.bridgeWidth = (float)uniformBetween(random, 10, 29);
+	serverIn.bridgeLength = (float)uniformBetween(random, 20, 219);
+	serverIn.componentType = StructureComponentTypeDeck;
+	return bridgeInfoCompiler(userIn, serverIn);
+}
+
+/*
+ * Function: sameRepairs
+ * -------------------------------------------------------
+ * Whether the schedules do the same repairs in the same years; the values of the repairs are
+ * not compared, the original kernels do not fill them in.
+ */
+static bool sameRepairs(const RepairSchedule &schedule, const RepairSchedule &expected)
+{
+	if (schedule.size() != expected.size())
+		return false;
+	for (int i = 0; i < schedule.size(); i++) {
+		if (schedule[i].repairID != expected[i].repairID || schedule[i].repairYear != expected[i].repairYear)
+			return false;
+	}
+	return true;
+}
+
+/*
+ * Implementation: scheduleEquivalenceTests
+ * ------------------------------
+ * Every objective 1-11 in turn, over the component types. The baseline gets the repairs
+ * joined by the scan form of envInfoCompiler, the current code those joined through the
+ * catalog. Scenarios whose ratings ratingDecay rejects, or whose decay runs past year 100 of
+ * the fixed arrays, are skipped.
+ */
+void scheduleEquivalenceTests()
+{
+	RepairBasicInfoMat basicInfo = readRepairBasicInfo();
+	vector<EnvCoefMat> envCoefs(12);
+	vector<RepairCatalog> catalogs(12);
+	for (int optObj = 1; optObj <= 11; optObj++) {
+		envCoefs[optObj] = readEnvCoef(optObj);
+		catalogs[optObj] = repairCatalogCompiler(basicInfo, envCoefs[optObj]);
+	}
+
+	ImproveMat impMat;
+	const int conditions[3] = { 4, 5, 6 };
+	const float coefficients[3] = { 0.15f, 0.1f, 0.05f };
+	for (int c = 0; c < 3; c++) {
+		ImpCoef imp;
+		imp.condition = conditions[c];
+		imp.coef = coefficients[c];
+		impMat.push_back(imp);
+	}
+
+	SampleStream random(scenarioSeed, 0);
+	int solved = 0;
+	int withRepairs = 0;
+	for (int s = 0; s < nScenarios; s++) {
+		int optObj = 1 + s % 11;
+		string componentType = componentTypes[s % 7];
+		RepairInfoMat repairUserIn = randomRepairs(random, basicInfo, envCoefs[optObj]);
+		BridgeInfo bridge = randomBridge(random, s, optObj);
+		int limit = uniformBetween(random, 3, 5);
+		ComponentRatingMat ratings = randomRatings(random);
+
+		int ratingsDecay[10][10];
+		try {
+			ratingDecay(ratingsDecay, ratings, limit);
+		} catch (const BlackBoxError &) {
+			continue;
+		}
+		bool inHorizon = true;
+		for (int i = 9; i >= limit; i--) {
+			for (int j = i; j >= limit; j--)
+				inHorizon = inHorizon && ratingsDecay[i][j] >= 0 && ratingsDecay[i][j] < bridge.nYears;
+		}
+		if (!inHorizon)
+			continue;
+
+		RepairEnvMat baselineRepairs = envInfoCompiler(repairUserIn, componentType, basicInfo, envCoefs[optObj]);
+		RepairEnvMat repairs = envInfoCompiler(repairUserIn, componentType, basicInfo, envCoefs[optObj], catalogs[optObj]);
+		CostMap costs = readRepairCost(repairUserIn);
+		YearFactors factors = yearFactorsCompiler(bridge, bridge.nYears);
+
+		RepairSchedule expected, schedule;
+		float expectedMinimum, minimum;
+		if (optObj == 11) {
+			expectedMinimum = baselineCostSchedule(bridge, ratingsDecay, baselineRepairs, costs, impMat, limit, expected);
+			minimum = findOptCostSchedule(bridge, ratingsDecay, repairs, costs, impMat, factors, limit, schedule, "");
+		} else {
+			expectedMinimum = baselineEnvSchedule(bridge, ratingsDecay, baselineRepairs, impMat, limit, expected);
+			minimum = findOptEnvSchedule(bridge, ratingsDecay, repairs, impMat, factors, limit, schedule, "");
+		}
+
+		ostringstream scenario;
+		scenario << "scenario " << s << " (objective " << optObj << ", " << componentType << ")";
+		CHECK(minimum == expectedMinimum || (minimum != minimum && expectedMinimum != expectedMinimum),
+			"minimum of " + scenario.str());
+		CHECK(sameRepairs(schedule, expected), "schedule of " + scenario.str());
+		solved++;
+		withRepairs += !expected.empty();
+	}
+
+	// the random histories must leave enough scenarios, and enough with repairs, to mean something
+	CHECK(solved >= nScenarios/2, "fewer than half of the scenarios were solved");
+	CHECK(withRepairs >= solved/4, "fewer than a quarter of the schedules have repairs");
+}
@@ -0,0 +1,96 @@
+//
+//  SenStoreStandInTest.cpp
+//  tests
+//
+//  The SenStore stand-in served on a local adapter, called through a SenStoreMngr proxy by
+//  the functions of Input.cpp and Output.cpp as the black box calls SenStore. The requests
+//  and results therefore go through the marshaling of the generated code and back.
+//
+
+#include <Ice/Ice.h>
+#include "Tests.h"
+#include "Input.h"
+#include "Output.h"
+#include "SenStoreStandIn.h"
+
+// the stand-in's fixtures, relative to the blackBox directory the tests run in
+static const char *const fixtureDirectory = "Fixtures";
+
+static void readTests(const SenStoreMngrPrx &manager)
+{
+	ServerInput deck = readServerInput(manager, 1, 1);
+	CHECK(deck.bridgeLength == 120.5f && deck.bridgeWidth == 14.2f, "size of bridge 1");
+	CHECK(deck.componentType == StructureComponentTypeDeck, "type of component 1");
+	CHECK(readServerInput(manager, 3, 6).componentType == StructureComponentTypeColumn, "type of component 6");
+
+	ComponentRatingMat ratings = readRatings(manager, 2, 1);
+	CHECK(ratings.ratings.size() == 14 && ratings.years.size() == 14, "number of the ratings of bridge 2");
+	if (ratings.ratings.size() == 14) {
+		CHECK(ratings.years.front() == 1985 && ratings.years.back() == 2024, "years of the ratings of bridge 2");
+		CHECK(ratings.ratings.front() == 9 && ratings.ratings[6] == 6 && ratings.ratings.back() == 0, "ratings of bridge 2");
+	}
+
+	bool thrown = false;
+	try {
+		readServerInput(manager, 9, 1);
+	} catch (const SenStore::ObjectDoesNotExistError &) {
+		thrown = true;
+	}
+	CHECK(thrown, "an unknown bridge was found");
+
+	thrown = false;
+	try {
+		readRatings(manager, 1, 4);
+	} catch (const BlackBoxError &) {
+		thrown = true;
+	}
+	CHECK(thrown, "a component without assessments has ratings");
+}
+
+/*
+ * Function: writeTests
+ * -------------------------------------------------------
+ * A repair without a ComponentRepairOption is not written.
+ */
+static void writeTests(const SenStoreMngrPrx &manager, const SenStoreStandInIPtr &standIn)
+{
+	CHECK(writeToServer(manager, 1, 1, (OptimizationObjective)(11 - 1), 20120101, findEnvImpactType(11), findUnit(11), 1234.5f) == 0,
+		"writeToServer failed");
+	CHECK(standIn->written() == 1, "writeToServer did not add one row");
+
+	LCO::ScheduledRepairSeq schedule(3);
+	const int repairIDs[3] = { 3, 99, 12 };
+	for (int r = 0; r < 3; r++) {
+		schedule[r].repairID = repairIDs[r];
+		schedule[r].year = 2020 + 10*r;
+		schedule[r].value = 100.0f*r;
+	}
+	CHECK(writeScheduleToServer(manager, 1, 1, (OptimizationObjective)(11 - 1), 20120101, schedule) == 0, "writeScheduleToServer failed");
+	CHECK(standIn->written() == 3, "writeScheduleToServer did not add one row per repair");
+}
+
+/*
+ * Implementation: senStoreStandInTests
+ * ------------------------------
+ * The stand-in is a Blobject, so the proxy must not be collocation optimized, as in SenStorePool.
+ */
+void senStoreStandInTests()
+{
+	Ice::InitializationData initData;
+	initData.properties = Ice::createProperties();
+	Ice::CommunicatorPtr ic = Ice::initialize(initData);
+	try {
+		Ice::ObjectAdapterPtr adapter = ic->createObjectAdapterWithEndpoints("SenStoreStandInTest", "tcp -h 127.0.0.1");
+		SenStoreStandInIPtr standIn = new SenStoreStandInI(fixtureDirectory);
+		Ice::ObjectPrx proxy = adapter->addWithUUID(standIn);
+		adapter->activate();
+		SenStoreMngrPrx manager = SenStoreMngrPrx::uncheckedCast(proxy->ice_collocationOptimized(false));
+
+		readTests(manager);
+		writeTests(manager, standIn);
+	} catch (...) {
+		ic->destroy();
+		throw;
+	}
+	ic->destroy();
+}
@@ -0,0 +1,32 @@
+//
+//  Tests.h
+//  tests
+//
+//  The checks of the tests executable. Every suite is a function that makes its checks with
+//  CHECK; a failed check is reported with its file and line, and the suite goes on.
+//
+
+#ifndef tests_Tests_h
+#define tests_Tests_h
+
+#include <string>
+
+using namespace std;
+
+/*
+ * Macro: CHECK
+ * Usage: CHECK(minimum == expected, "minimum of scenario " + name);
+ * -----------------------------------------------------------------------------
+ * Counts the check, and reports "what" with the place of the check if "condition" is false.
+ */
+#define CHECK(condition, what) checkResult((condition), (what), __FILE__, __LINE__)
+
+void checkResult(bool passed, const string &what, const char *file, int line);
+
+/* the suites, run in this order by main */
+void scheduleEquivalenceTests();
+void decaySamplingTests();
+void resultCacheTests();
+void senStoreStandInTests();
+
+#endif
@@ -0,0 +1,53 @@
+//
+//  tests.cpp
+//  tests
+//
+//  Runs the test suites and returns 1 if a check failed. The suites read the Data files, so
+//  the working directory must be blackBox, as for the post-build step of the project.
+//
+//  Usage: tests
+//
+
+#include <iostream>
+#include "Tests.h"
+#include "LCO.h"
+
+static int checksRun = 0;
+static int checksFailed = 0;
+
+void checkResult(bool passed, const string &what, const char *file, int line)
+{
+	checksRun++;
+	if (!passed) {
+		checksFailed++;
+		cerr << file << "(" << line << "): check failed: " << what << endl;
+	}
+}
+
+/*
+ * Function: runSuite
+ * -------------------------------------------------------
+ * An exception out of a suite fails it and the suites after it still run.
+ */
+static void runSuite(const char *name, void (*suite)())
+{
+	cout << name << endl;
+	try {
+		suite();
+	} catch (const LCO::BlackBoxError &ex) {
+		checkResult(false, string(name) + " threw " + ex.reason, __FILE__, __LINE__);
+	} catch (const std::exception &ex) {
+		checkResult(false, string(name) + " threw " + ex.what(), __FILE__, __LINE__);
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	runSuite("scheduleEquivalenceTests", scheduleEquivalenceTests);
+	runSuite("decaySamplingTests", decaySamplingTests);
+	runSuite("resultCacheTests", resultCacheTests);
+	runSuite("senStoreStandInTests", senStoreStandInTests);
+
+	cout << checksRun - checksFailed << " of " << checksRun << " checks passed" << endl;
+	return checksFailed == 0 ? 0 : 1;
+}